@@ -23,6 +23,28 @@
 ; generator.
 (define close-fraction (Predicate "*-close-fraction-*"))
 
+; Adapt the random draws to how the assembly is going. If non-zero,
+; the random network generator raises the close-fraction as the number
+; of open connectors approaches the remaining room in the network, and
+; more often rejects pieces with many connectors. Zero, the default,
+; keeps the close-fraction fixed.
+(define adaptive (Predicate "*-adaptive-*"))
+
+; Restart policy for the random network generator. A random network
+; that takes a bad turn early on can wander for a long time before
+; giving up. A restart abandons the current network, and starts again
+; from a freshly drawn root. The policy is one of
+;    (Concept "none")      -- never restart (the default)
+;    (Concept "fixed")     -- restart after `restart-steps` steps
+;    (Concept "luby")      -- restart after `restart-steps` times the
+;                             Luby sequence 1,1,2,1,1,2,4,1,1,2,...
+;    (Concept "geometric") -- restart after `restart-steps` times
+;                             `restart-growth` to the power of the
+;                             number of attempts so far.
+(define restart-policy (Predicate "*-restart-policy-*"))
+(define restart-steps (Predicate "*-restart-steps-*"))
+(define restart-growth (Predicate "*-restart-growth-*"))
+
 ; Maximum number of odometer steps to take, when searching for a
 ; solution. It's not hard to specify grammars with weighting that lead
 ; to infinite trees, (i.e. are infinitely recursive) and so it's
@@ -43,6 +65,70 @@
 ; this number of points in them will not be explored.
 (define max-network-size (Predicate "*-max-network-size-*"))
 
+; Set to 1 to keep only one network of each shape. Networks are the
+; same shape if they are isomorphic, when the unique point names are
+; replaced by the names of the points in the dictionary. Each network
+; that is kept is marked with the number of times its shape was seen,
+; as a FloatValue on the key (Predicate "*-shape-count-*").
+(define dedupe-isomorphic (Predicate "*-dedupe-isomorphic-*"))
+
+; The search strategy, given as a ConceptNode:
+;    "breadth-first" -- extend all open connectors at once, before
+;                       going deeper. This is the default.
+;    "depth-first"   -- extend one open connector at a time. This uses
+;                       less memory, and is faster for grammars with
+;                       few choices per connector.
+;    "iterative-deepening" -- repeat the depth-first search, allowing
+;                       one more point each time. Finds the smallest
+;                       networks first, using little memory.
+;    "meet-in-the-middle" -- for several roots (given as a SetLink):
+;                       grow each root on its own, out to the meet
+;                       radius, then join the pieces up.
+(define strategy (Predicate "*-strategy-*"))
+
+; For the "meet-in-the-middle" strategy: how far out, counted in
+; points, each root is grown before the roots are joined up.
+(define meet-radius (Predicate "*-meet-radius-*"))
+
+; Set to 1 to generate only networks that can be drawn without any
+; links crossing, taking the connectors in each section to be listed
+; clockwise around the point (in the dictionaries of the examples,
+; left-pointing connectors nearest-first, then right-pointing ones
+; farthest-first). Links that would cross are never made. The order
+; is fixed: networks that are planar only when the connectors are
+; taken in some other order are refused as well.
+(define planar (Predicate "*-planar-*"))
+
+; Set to 1 to generate only networks that are planar, with the bottoms
+; of all of the points on one face, so that the points can be put on a
+; line with the links drawn above it. This is weaker than the
+; no-crossing rule of Link Grammar: the order of the points along the
+; line, and so whether each link points left or right, is not checked.
+(define projective (Predicate "*-projective-*"))
+
+; The maximum number of links of a given type, for example, at most
+; one subject and one object link per sentence. Link types that are
+; not listed can appear any number of times. Given as a list of
+; pairs:
+;    (State (Member link-limits params)
+;       (List (List (Concept "S") (Number 1)) (List (Concept "O") (Number 1))))
+(define link-limits (Predicate "*-link-limits-*"))
+
+; Pairs of connectors that must close cycles. When an open section
+; could take such a link, it must, instead of a fresh piece being
+; drawn from the dictionary. For example, to have the wall-verb link
+; close the wall-noun-verb triangle:
+;    (State (Member must-close params)
+;       (List (List (Connector (Concept "WV") (ConnectorDir "+"))
+;                   (Connector (Concept "WV") (ConnectorDir "-")))))
+(define must-close (Predicate "*-must-close-*"))
+
+; Number of fully-explored partial networks to remember. A partial
+; network that is the same as one that was already fully explored
+; (up to the unique point names) is not explored a second time.
+; Zero, the default, disables this. Most useful for exhaustive search.
+(define max-transpositions (Predicate "*-max-transpositions-*"))
+
 ; When the network is generated, many individual instances of the
 ; network points will be generated. To get easy access to these, they
 ; can be tied at a well-known location -- specifically, they will
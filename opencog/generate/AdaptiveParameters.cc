@@ -0,0 +1,70 @@
+/*
+ * opencog/generate/AdaptiveParameters.cc
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <cmath>
+
+#include "AdaptiveParameters.h"
+
+using namespace opencog;
+
+AdaptiveParameters::AdaptiveParameters()
+{}
+
+AdaptiveParameters::AdaptiveParameters(const BasicParameters& basic) :
+	BasicParameters(basic)
+{}
+
+AdaptiveParameters::~AdaptiveParameters()
+{}
+
+/// Return a number between zero and one, indicating how close the
+/// frame is to running out of room. This is the ratio of the number
+/// of unconnected connectors, to the number of sections that may still
+/// be added, before the network reaches `max_size` sections. Each open
+/// connector needs either another open connector, or a new section, to
+/// close it.
+double AdaptiveParameters::pressure(const Frame& frm, size_t max_size)
+{
+	size_t size = frm._linkage.size() + frm._open_sections.size();
+	if (max_size <= size) return 1.0;
+
+	double room = max_size - size + 1;
+	return std::min(1.0, frm._open_count / room);
+}
+
+/// Interpolate between `close_fraction` (when there is plenty of room)
+/// and always closing (when there is no more room).
+double AdaptiveParameters::connect_existing(const Frame& frm,
+                                            size_t max_size)
+{
+	double press = pressure(frm, max_size);
+	return close_fraction + (1.0 - close_fraction) * press;
+}
+
+/// Pieces with `arity` connectors are accepted with probability
+/// `(1-p)^(arity-1)` where `p` is the pressure. Pieces with a single
+/// connector add no new open connectors, and are always accepted.
+double AdaptiveParameters::accept_arity(const Frame& frm, size_t max_size,
+                                        size_t arity)
+{
+	if (arity <= 1) return 1.0;
+	return std::pow(1.0 - pressure(frm, max_size), arity - 1);
+}
@@ -0,0 +1,59 @@
+/*
+ * opencog/generate/AdaptiveParameters.h
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_ADAPTIVE_PARAMETERS_H
+#define _OPENCOG_ADAPTIVE_PARAMETERS_H
+
+#include <opencog/generate/BasicParameters.h>
+
+namespace opencog
+{
+/** \addtogroup grp_generate
+ *  @{
+ */
+
+/// The AdaptiveParameters class adjusts the choices made by the
+/// RandomCallback according to how the assembly is going. As the
+/// number of unconnected connectors approaches the number of sections
+/// that may still be added, it becomes ever more likely that existing
+/// connectors are joined together, and that new pieces with few
+/// connectors are drawn. When there is plenty of room, it behaves the
+/// same as BasicParameters.
+
+class AdaptiveParameters : public BasicParameters
+{
+protected:
+	double pressure(const Frame&, size_t);
+
+public:
+	AdaptiveParameters();
+	AdaptiveParameters(const BasicParameters&);
+	virtual ~AdaptiveParameters();
+
+	virtual double connect_existing(const Frame&, size_t);
+	virtual double accept_arity(const Frame&, size_t, size_t);
+};
+
+
+/** @}*/
+}  // namespace opencog
+
+#endif // _OPENCOG_ADAPTIVE_PARAMETERS_H
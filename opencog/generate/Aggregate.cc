@@ -17,6 +17,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
 #include <stdio.h>
 
 #include <opencog/util/Logger.h>
@@ -27,6 +28,7 @@
 
 #include "Aggregate.h"
 #include "GenerateCallback.h"
+#include "ThreadPool.h"
 
 using namespace opencog;
 
@@ -39,6 +41,14 @@ Aggregate::Aggregate(AtomSpace* as)
 {
 	_cb = nullptr;
 	_scratch = nullptr;
+	_explored_next = 0;
+	_halts = 0;
+	_deepening = false;
+	_limit_cuts = 0;
+	_report_from = 0;
+	_parts = nullptr;
+	_radius = 0;
+	_cancel = false;
 }
 
 Aggregate::~Aggregate()
@@ -50,12 +60,20 @@ Aggregate::~Aggregate()
 void Aggregate::clear(void)
 {
 	while (not _frame_stack.empty()) _frame_stack.pop();
-	while (not _odo_sections.empty()) _odo_sections.pop();
+	while (not _slot_marks.empty()) _slot_marks.pop();
+	_slot_trail.clear();
 	while (not _odo_stack.empty()) _odo_stack.pop();
 
 	_frame.clear();
 	_odo.clear();
 
+	_explored.clear();
+	_explored_index.clear();
+	_explored_next = 0;
+	_halts = 0;
+	_fixed.clear();
+	_pinned.clear();
+
 	if (_scratch) delete _scratch;
 	_scratch = new AtomSpace(_as);
 	_cb->clear(_scratch);
@@ -64,27 +82,159 @@ void Aggregate::clear(void)
 /// The nuclei are the nucleation points: points that must
 /// appear in sections, some section of which must be linkable.
 ///
+/// A `cancel()` applies to the run that is under way, or else to the
+/// next one; it is forgotten when a new run is started.
 void Aggregate::aggregate(const HandleSet& nuclei,
                           GenerateCallback& cb)
+{
+	_cancel = false;
+	do_aggregate(nuclei, cb);
+}
+
+void Aggregate::do_aggregate(const HandleSet& nuclei,
+                             GenerateCallback& cb)
 {
 	_cb = &cb;
 	clear();
 
 	// Set it up and go.
 	_cb->root_set(nuclei);
-	while (true)
+	while (not _cancel)
 	{
 		HandleSet starters = _cb->next_root();
 		if (starters.size() == 0) break;
 
 		push_frame();
 		for (const Handle& sect : starters)
+			add_open(sect);
+		search();
+		pop_frame();
+	}
+}
+
+/// Extend an existing network. The sections of `network` that still
+/// have unconnected connectors are connected up, just as if they had
+/// been drawn during the search; the complete ones take no part in
+/// the search at all, and are only added back in to each solution.
+/// Thus, the search costs the same no matter how large the rest of
+/// the network is; the limits on network size apply only to the part
+/// that is searched (the open sections, and what is added to them).
+///
+/// This is a single search; the callback is not asked for roots.
+/// The links already in the network are not drawn, so planarity
+/// cannot be checked.
+void Aggregate::extend(const HandleSet& network,
+                       GenerateCallback& cb)
+{
+	_cancel = false;
+	_cb = &cb;
+	clear();
+
+	if (_cb->planar or _cb->projective)
+		throw RuntimeException(TRACE_INFO,
+			"Cannot check planarity when extending a network");
+
+	push_frame();
+	HandleSet links;
+	for (const Handle& sect : network)
+	{
+		bool is_open = false;
+		for (const Handle& con : sect->getOutgoingAtom(1)->getOutgoingSet())
+		{
+			if (CONNECTOR == con->get_type()) is_open = true;
+			else links.insert(con);
+		}
+		if (is_open)
 		{
-			_frame._open_sections.insert(sect);
+			add_open(sect);
+			_pinned.insert(sect->getOutgoingAtom(0));
 		}
+		else
+			_fixed.push_back(sect);
+	}
+
+	// The links already made count towards the limits.
+	if (not _cb->link_limits.empty())
+	{
+		for (const Handle& lnk : links)
+		{
+			const Handle& linkty = lnk->getOutgoingAtom(0);
+			_frame._link_counts.set(linkty,
+				_frame._link_counts.get(linkty, 0) + 1);
+		}
+	}
+	logger().fine("Extend %lu open sections, with %lu complete ones",
+		_frame._open_sections.size(), _fixed.size());
+
+	search();
+	pop_frame();
+}
+
+/// Add `sect`, a section with unconnected connectors, to the current
+/// frame, as if it had just been drawn.
+void Aggregate::add_open(const Handle& sect)
+{
+	_frame._open_sections.insert(sect);
+	_frame._hash += Shape::section_key(sect);
+	if (_cb->planar or _cb->projective)
+		_frame._embedding.add_section(sect);
+	_cb->open_section(sect);
+	for (const Handle& con : sect->getOutgoingAtom(1)->getOutgoingSet())
+		if (CONNECTOR == con->get_type())
+			_frame.open_connector(con);
+}
+
+/// Search from the current frame, in the way the callback asks for.
+void Aggregate::search(void)
+{
+	if (GenerateCallback::ITERATIVE_DEEPENING == _cb->strategy)
+		deepen();
+	else if (GenerateCallback::MEET_IN_THE_MIDDLE == _cb->strategy)
+		meet();
+	else if (GenerateCallback::DEPTH_FIRST == _cb->strategy)
+		recurse_depth();
+	else
 		recurse();
-		pop_frame();
+}
+
+/// Hand the current (closed) frame to the callback, together with
+/// the complete sections of the network being extended, if any.
+void Aggregate::emit(void)
+{
+	if (_fixed.empty())
+	{
+		_cb->solution(_frame);
+		return;
 	}
+
+	Frame full(_frame);
+	for (const Handle& sect : _fixed)
+		full._linkage.insert(sect);
+	_cb->solution(full);
+}
+
+/// Run `aggregate()` on the shared thread pool, and return at once.
+/// The future holds the solutions (as returned by `get_solutions()`)
+/// once it is done. Both this aggregator and the callback must stay
+/// alive, and must not be otherwise used, until then. The job can be
+/// stopped early with `cancel()`; the future then holds whatever was
+/// found before the cancellation was noticed.
+std::future<Handle> Aggregate::aggregate_async(const HandleSet& nuclei,
+                                               GenerateCallback& cb)
+{
+	// Forget old cancels now, rather than when the job gets to run,
+	// so that a cancel made while the job is waiting is not lost.
+	_cancel = false;
+	auto job = std::make_shared<std::packaged_task<Handle()>>(
+		[this, nuclei, &cb](void)
+		{
+			do_aggregate(nuclei, cb);
+			return cb.get_solutions();
+		});
+
+	std::future<Handle> fut = job->get_future();
+	ThreadPool::shared().submit([job](void) { (*job)(); });
+	return fut;
 }
 
 /// Breadth-first recursion.
@@ -95,13 +245,22 @@ void Aggregate::recurse(void)
 	if (0 == _frame._open_sections.size()) return;
 
 	// Halt recursion, if need be.
-	if (not _cb->step(_frame))
+	if (_cancel or not _cb->step(_frame))
 	{
 		logger().fine("Recursion halted at frame depth=%lu odo level=%lu",
 			_frame_stack.size(), _odo_stack.size());
+		_halts++;
 		return;
 	}
 
+	// Been here before?
+	if (was_explored())
+	{
+		logger().fine("Transposition: frame already explored");
+		return;
+	}
+	size_t halts = _halts;
+
 	logger().fine("Enter recurse");
 
 	// Initialize a brand-new odometer at the next recursion level.
@@ -110,6 +269,7 @@ void Aggregate::recurse(void)
 	if (not more)
 	{
 		pop_odo();
+		set_explored();
 		return;
 	}
 
@@ -121,10 +281,11 @@ void Aggregate::recurse(void)
 	logger().fine("Recurse: After first step, have-more=%d", more);
 	while (true)
 	{
-		// Odometer is exhausted; we are done.
-		if (not more)
+		// Odometer is exhausted (or we were cancelled); we are done.
+		if (not more or _cancel)
 		{
 			pop_odo();
+			if (halts == _halts and not _cancel) set_explored();
 			return;
 		}
 
@@ -140,6 +301,462 @@ void Aggregate::recurse(void)
 	return; // *not-reached*
 }
 
+/// Deepest that the depth-first search may recurse, in frames.
+static const size_t max_recursion = 4096;
+
+/// Depth-first recursion. Instead of attaching pieces to all of the
+/// open connectors at once, as the odometer does, attach a piece to
+/// just one of them, and recurse; the other mates for that connector
+/// are tried on the way back up. Every completed assembly connects
+/// that connector to something, so this finds each assembly along
+/// exactly one path. Each connection is made in its own frame; since
+/// frames share structure, the memory used grows with the depth only.
+///
+/// Connecting to a section that is already in the assembly closes a
+/// cycle in the network; it is handled like any other connection, and
+/// never revisits a point. Cycles in the grammar, which would otherwise
+/// be unrolled forever, are cut by `max_network_size` (through
+/// `unclosable()`), by `max_depth` (the distance of the newest piece
+/// from the nuclei) and by `step()`. If `max_transpositions` is set,
+/// assemblies reached along different paths are explored only once.
+///
+/// Each connection is one level of recursion; the search is cut at
+/// `max_recursion` levels, so that it cannot run off the end of the
+/// C++ stack when the limits are left unset.
+void Aggregate::recurse_depth(void)
+{
+	// Halt recursion, if need be.
+	if (_cancel or not _cb->step(_frame))
+	{
+		logger().fine("Depth-first recursion halted at frame depth=%lu",
+			_frame_stack.size());
+		_halts++;
+		return;
+	}
+	if (max_recursion < _frame_stack.size())
+	{
+		logger().fine("Depth-first recursion cut at frame depth=%lu",
+			_frame_stack.size());
+		_halts++;
+		return;
+	}
+
+	// Been here before?
+	if (was_explored())
+	{
+		logger().fine("Transposition: frame already explored");
+		return;
+	}
+	size_t halts = _halts;
+
+	Handle fm_sect;
+	size_t offset;
+	HandleSeq to_cons;
+	if (not pick_connector(fm_sect, offset, to_cons))
+	{
+		set_explored();
+		return;
+	}
+
+	// While growing out from a single nucleus, keep every partial
+	// assembly; stop at the edge of the radius.
+	if (_parts) _parts->push_back(_frame);
+	if (nullptr == fm_sect) return;
+
+	// This connector must be linked, and it cannot be.
+	Handle fm_con(fm_sect->getOutgoingAtom(1)->getOutgoingAtom(offset));
+	if (at_limit(_frame, fm_con))
+	{
+		logger().fine("Link limit: cannot connect at depth %lu",
+			_frame_stack.size());
+		set_explored();
+		return;
+	}
+
+	size_t dist = _frame._distance.get(fm_sect->getOutgoingAtom(0), 0);
+
+	// The callbacks keep their lexis iterators per odometer; this
+	// connector gets its own.
+	_cb->push_odometer(_odo);
+	bool halted = false;
+	for (const Handle& to_con : to_cons)
+	{
+		Handle to_sect = _cb->select(_frame, fm_sect, offset, to_con);
+		while (nullptr != to_sect and not _cancel)
+		{
+			bool fresh = not _frame._open_sections.contains(to_sect);
+			if (crosses(fm_sect, offset, to_sect, to_con))
+			{
+				logger().fine("Planarity: skip crossing link at depth %lu",
+					_frame_stack.size());
+			}
+			else if (opens_cycle(fm_sect, offset, to_sect, to_con))
+			{
+				logger().fine("Cycle: skip fresh piece at depth %lu",
+					_frame_stack.size());
+			}
+			else
+			{
+				push_frame();
+				_frame._reach = fresh ? dist + 1 : dist;
+				if (fresh)
+					_frame._distance.set(to_sect->getOutgoingAtom(0), dist + 1);
+				connect_section(fm_sect, offset, to_sect, to_con);
+
+				if (unclosable())
+					logger().fine("Cut unclosable frame at depth %lu",
+						_frame_stack.size());
+				else if (0 == _frame._open_sections.size())
+					report();
+				else
+					recurse_depth();
+				pop_frame();
+			}
+
+			// Each alternative counts as a step, so that callbacks
+			// that never run out of pieces will still halt.
+			if (not _cb->step(_frame))
+			{
+				_halts++;
+				halted = true;
+				break;
+			}
+			to_sect = _cb->select(_frame, fm_sect, offset, to_con);
+		}
+		if (halted or _cancel) break;
+	}
+	_cb->pop_odometer(_odo);
+
+	if (halts == _halts and not _cancel) set_explored();
+}
+
+/// Number of explored frames to remember while deepening or meeting,
+/// if the callback does not ask for more.
+static const size_t default_transpositions = 4096;
+
+/// Iterative deepening. Run the depth-first search over and over,
+/// allowing one more section in the network each time, starting with
+/// the fewest sections that could possibly close the root frame. The
+/// networks are thus found smallest first, while the memory used is
+/// that of a single depth-first search.
+///
+/// The transposition table is kept from one iteration to the next.
+/// A frame is entered into it only if it was explored without ever
+/// bumping into the size limit; such a frame is complete, and the
+/// later iterations skip it. Thus the shallow levels, which would
+/// otherwise be re-explored on every iteration, are mostly cached.
+///
+/// Stops once an iteration finishes without having been cut by the
+/// size limit (there is nothing bigger to find), when the callback's
+/// own `max_network_size` is reached, or when `step()` says so.
+void Aggregate::deepen(void)
+{
+	size_t max_size = _cb->max_network_size;
+	size_t max_trans = _cb->max_transpositions;
+	if (0 == max_trans) _cb->max_transpositions = default_transpositions;
+
+	size_t need = _cb->min_to_close(_frame);
+	size_t limit = _frame._linkage.size() + _frame._open_sections.size();
+	if (SIZE_MAX != need) limit += need;
+	if (max_size < limit) limit = max_size;
+
+	_deepening = true;
+	_report_from = 0;
+	while (not _cancel)
+	{
+		logger().fine("Deepen to network size %lu", limit);
+		_cb->max_network_size = limit;
+		size_t cuts = _limit_cuts;
+		recurse_depth();
+
+		if (cuts == _limit_cuts or max_size <= limit) break;
+		if (not _cb->step(_frame))
+		{
+			_halts++;
+			break;
+		}
+		_report_from = limit + 1;
+		limit ++;
+	}
+	_deepening = false;
+	_report_from = 0;
+
+	_cb->max_network_size = max_size;
+	_cb->max_transpositions = max_trans;
+}
+
+/// Report the current (closed) frame as a solution, unless it is
+/// too small to be reported, or, if transpositions are being kept,
+/// the same network (up to the unique point names) was already
+/// reported along some other path.
+void Aggregate::report(void)
+{
+	// Assemblies grown from a single nucleus are not solutions.
+	if (_parts) return;
+	if (_frame._linkage.size() < _report_from) return;
+	if (was_explored()) return;
+	set_explored();
+	emit();
+}
+
+/// Choose the open connector that the depth-first search connects
+/// next: the one with the fewest mating connectors, so that dead ends
+/// are found early. Returns false if some open connector has no mates
+/// at all, as the frame can then never be completed. While growing
+/// out from a nucleus, only connectors on points inside the radius
+/// are chosen; `fm_sect` is left null if there are none.
+bool Aggregate::pick_connector(Handle& fm_sect, size_t& offset,
+                               HandleSeq& to_cons)
+{
+	fm_sect = Handle::UNDEFINED;
+	for (const Handle& sect: _frame._open_sections)
+	{
+		bool inside = nullptr == _parts or
+			_frame._distance.get(sect->getOutgoingAtom(0), 0) < _radius;
+
+		const HandleSeq& conseq = sect->getOutgoingAtom(1)->getOutgoingSet();
+		for (size_t idx = 0; idx < conseq.size(); idx++)
+		{
+			if (CONNECTOR != conseq[idx]->get_type()) continue;
+
+			const HandleSeq& mates = _cb->joints(conseq[idx]);
+			if (0 == mates.size()) return false;
+			if (not inside) continue;
+			if (fm_sect and to_cons.size() <= mates.size()) continue;
+
+			fm_sect = sect;
+			offset = idx;
+			to_cons = mates;
+		}
+	}
+	return true;
+}
+
+/// Meet-in-the-middle. Grow partial assemblies out of each nucleus,
+/// on its own, to a distance of `meet_radius` pieces; then join the
+/// partial assemblies of the different nuclei, wherever an open
+/// connector on one mates with an open connector on the other, and
+/// finish each joined assembly with the depth-first search. A network
+/// in which the nuclei are far apart is thus found with a few searches
+/// of half the depth, rather than one search of the full depth.
+///
+/// The growth of the different nuclei is independent, but it uses the
+/// one callback, and so it is done one nucleus after another. The
+/// partial assemblies are frame snapshots, which share structure, and
+/// so are cheap to keep.
+void Aggregate::meet(void)
+{
+	// The open sections of a network being extended are already
+	// joined up, through the rest of it; they are not nuclei.
+	if (_frame._open_sections.size() < 2 or not _pinned.empty())
+	{
+		recurse_depth();
+		return;
+	}
+
+	// The growth is cut off at the radius, and so nothing that it
+	// explores is complete; keep it out of the transposition table.
+	size_t max_trans = _cb->max_transpositions;
+	_cb->max_transpositions = 0;
+	_radius = _cb->meet_radius;
+
+	std::vector<std::vector<Frame>> parts;
+	HandleSeq nuclei(_frame._open_sections.begin(),
+	                 _frame._open_sections.end());
+	for (const Handle& nucleus : nuclei)
+	{
+		Frame seed;
+		seed.clear();
+		seed._open_sections.insert(nucleus);
+		seed._hash = Shape::section_key(nucleus);
+		if (_cb->planar or _cb->projective)
+			seed._embedding.add_section(nucleus);
+		for (const Handle& con : nucleus->getOutgoingAtom(1)->getOutgoingSet())
+			if (CONNECTOR == con->get_type())
+				seed.open_connector(con);
+
+		std::vector<Frame> grown;
+		push_frame();
+		install(seed);
+		_parts = &grown;
+		recurse_depth();
+		_parts = nullptr;
+		pop_frame();
+
+		logger().fine("Grew %lu partial assemblies", grown.size());
+		parts.emplace_back(std::move(grown));
+	}
+	if (_cancel)
+	{
+		_cb->max_transpositions = max_trans;
+		return;
+	}
+
+	// Many joins lead to the same network; the table catches those.
+	_cb->max_transpositions =
+		(0 < max_trans) ? max_trans : default_transpositions;
+
+	std::vector<Frame> joined(std::move(parts[0]));
+	for (size_t i = 1; i < parts.size() and not _cancel; i++)
+		joined = join(joined, parts[i]);
+	logger().fine("Joined %lu assemblies", joined.size());
+
+	for (const Frame& frm : joined)
+	{
+		if (_cancel) break;
+		push_frame();
+		install(frm);
+		if (0 == _frame._open_sections.size())
+			report();
+		else
+			recurse_depth();
+		pop_frame();
+	}
+
+	_cb->max_transpositions = max_trans;
+}
+
+/// Return true if `sect` has the unconnected connector `con`.
+static bool has_connector(const Handle& sect, const Handle& con)
+{
+	for (const Handle& c : sect->getOutgoingAtom(1)->getOutgoingSet())
+		if (*c == *con) return true;
+	return false;
+}
+
+/// Return all of the ways of joining a partial assembly from `left`
+/// to one from `right`, by a single link between an open connector
+/// on the one and an open connector on the other. Joins that cannot
+/// be completed are dropped. Each join counts as a step.
+std::vector<Frame> Aggregate::join(const std::vector<Frame>& left,
+                                   const std::vector<Frame>& right)
+{
+	std::vector<Frame> joined;
+	for (const Frame& lfrm : left)
+	{
+		for (const Frame& rfrm : right)
+		{
+			Frame both(lfrm);
+			both.merge(rfrm);
+
+			for (const Handle& fm_sect : lfrm._open_sections)
+			{
+				const HandleSeq& conseq =
+					fm_sect->getOutgoingAtom(1)->getOutgoingSet();
+				for (size_t offset = 0; offset < conseq.size(); offset++)
+				{
+					if (CONNECTOR != conseq[offset]->get_type()) continue;
+					if (at_limit(both, conseq[offset])) continue;
+					for (const Handle& to_con : _cb->joints(conseq[offset]))
+					{
+						for (const Handle& to_sect : rfrm._open_sections)
+						{
+							if (not has_connector(to_sect, to_con)) continue;
+
+							if (_cancel or not _cb->step(_frame))
+							{
+								_halts++;
+								return joined;
+							}
+
+							push_frame();
+							install(both);
+							if (not crosses(fm_sect, offset, to_sect, to_con))
+							{
+								connect_section(fm_sect, offset, to_sect, to_con);
+								if (not unclosable())
+									joined.push_back(_frame);
+							}
+							pop_frame();
+						}
+					}
+				}
+			}
+		}
+	}
+	return joined;
+}
+
+/// Make `frm` the current frame, telling the callback which sections
+/// stop and start being open. Must follow a `push_frame()`, so that
+/// the matching `pop_frame()` undoes it.
+void Aggregate::install(const Frame& frm)
+{
+	HandleSeq gone;
+	for (const Handle& sect : _frame._open_sections)
+		if (not frm._open_sections.contains(sect))
+			gone.push_back(sect);
+	for (const Handle& sect : gone)
+		_cb->close_section(sect);
+
+	for (const Handle& sect : frm._open_sections)
+		if (not _frame._open_sections.contains(sect))
+			_cb->open_section(sect);
+
+	size_t nodo = _frame._nodo;
+	_frame = frm;
+	_frame._nodo = nodo;
+	_frame._wheel = -1;
+}
+
+/// The shape of a frame, with its open sections, up to the unique
+/// point names (except for the pinned points).
+Shape Aggregate::frame_shape(const PersistentHandleSet& linkage,
+                             const PersistentHandleSet& open) const
+{
+	HandleSet sects(linkage.begin(), linkage.end());
+	sects.insert(open.begin(), open.end());
+	return Shape(sects, true, _pinned);
+}
+
+/// Return true if a frame equivalent to the current frame has already
+/// been fully explored. The incremental hashes are compared first;
+/// only if some entry has the same hash are the shapes worked out,
+/// and the frames compared exactly.
+bool Aggregate::was_explored(void)
+{
+	if (0 == _cb->max_transpositions) return false;
+
+	auto range = _explored_index.equal_range(_frame._hash);
+	if (range.first == range.second) return false;
+
+	Shape shape(frame_shape(_frame._linkage, _frame._open_sections));
+	for (auto it = range.first; it != range.second; it++)
+	{
+		Explored& ent = _explored[it->second];
+		if (nullptr == ent.shape)
+			ent.shape.reset(new Shape(frame_shape(ent.linkage, ent.open)));
+		if (*ent.shape == shape) return true;
+	}
+	return false;
+}
+
+/// Record the current frame as fully explored. Once the table is
+/// full, the oldest entries are overwritten. This costs a few pointer
+/// copies; the shape is not worked out until it is needed.
+void Aggregate::set_explored(void)
+{
+	if (0 == _cb->max_transpositions) return;
+
+	Explored entry{_frame._hash, _frame._linkage, _frame._open_sections,
+	               nullptr};
+
+	size_t slot = _explored_next;
+	_explored_next = (_explored_next + 1) % _cb->max_transpositions;
+	if (_explored.size() <= slot)
+	{
+		_explored.emplace_back(std::move(entry));
+	}
+	else
+	{
+		auto range = _explored_index.equal_range(_explored[slot].hash);
+		for (auto it = range.first; it != range.second; it++)
+			if (it->second == slot) { _explored_index.erase(it); break; }
+		_explored[slot] = std::move(entry);
+	}
+	_explored_index.emplace(_frame._hash, slot);
+}
+
 /// Initialize the odometer state. This creates an ordered list of
 /// all as-yet unconnected connectors in the open state.
 /// Returns false if initialization failed, i.e. if the current
@@ -150,10 +767,16 @@ bool Aggregate::init_odometer(void)
 	_odo._from_index.clear();
 	_odo._to_connectors.clear();
 	_odo._sections.clear();
+	_odo._slot.clear();
+	_odo._slot_of.clear();
 
 	// Loop over all open connectors
 	for (const Handle& sect: _frame._open_sections)
 	{
+		size_t slot = _odo._sections.size();
+		_odo._sections.push_back(sect);
+		_odo._slot_of[sect] = slot;
+
 		Handle disj = sect->getOutgoingAtom(1);
 		const HandleSeq& conseq = disj->getOutgoingSet();
 		for (size_t idx = 0; idx < conseq.size(); idx++)
@@ -166,12 +789,12 @@ bool Aggregate::init_odometer(void)
 
 			// Get a list of connectors that can be connected to.
 			// If none, then this connector can never be closed.
-			HandleSeq to_cons = _cb->joints(from_con);
+			const HandleSeq& to_cons = _cb->joints(from_con);
 			if (0 == to_cons.size()) return false;
 
 			for (const Handle& to_con: to_cons)
 			{
-				_odo._sections.push_back(sect);
+				_odo._slot.push_back(slot);
 				_odo._from_index.push_back(idx);
 				_odo._to_connectors.push_back(to_con);
 			}
@@ -202,7 +825,7 @@ bool Aggregate::do_step(void)
 	bool did_step = false;
 	for (size_t ic = _odo._step; ic < _odo._size; ic++)
 	{
-		Handle fm_sect = _odo._sections[ic];
+		Handle fm_sect = _odo.section(ic);
 		size_t offset = _odo._from_index[ic];
 		const Handle& conseq = fm_sect->getOutgoingAtom(1);
 		const Handle& fm_con = conseq->getOutgoingAtom(offset);
@@ -223,40 +846,60 @@ bool Aggregate::do_step(void)
 				_odo._step = ic - 1;
 				return false;
 			}
+
 			continue;
 		}
 
 		// ----------------------------
 		// If we made it to here, then the to-connector is still free.
-		// Draw a new section to connect to it.
-		Handle to_sect = _cb->select(_frame, fm_sect, offset, to_con);
-
-		if (nullptr == to_sect)
+		// Draw a new section to connect to it. Pieces that leave the
+		// frame unclosable are disconnected again, and the next piece
+		// is drawn.
+		Handle to_sect = select(ic);
+		HandlePair hpr;
+		while (true)
 		{
-			logger().fine("Rolled over wheel %lu of %lu at depth %lu",
-			               ic, _odo._size, _odo_stack.size());
-			_odo.print_wheel(_frame, ic);
+			if (nullptr == to_sect)
+			{
+				logger().fine("Rolled over wheel %lu of %lu at depth %lu",
+				               ic, _odo._size, _odo_stack.size());
+				_odo.print_wheel(_frame, ic);
 
-			// If we are here, then this wheel has rolled over.
-			// That means that it's time for the previous wheel
-			// to take a step. Mark that wheel.
-			_odo._step = ic - 1;
-			return false;
+				// If we are here, then this wheel has rolled over.
+				// That means that it's time for the previous wheel
+				// to take a step. Mark that wheel.
+				_odo._step = ic - 1;
+				return false;
+			}
+
+			push_frame();
+			_frame._wheel = ic;
+
+			// Connect it up, and get the newly-connected section.
+			hpr = connect_section(fm_sect, offset, to_sect, to_con);
+			if (not unclosable()) break;
+
+			logger().fine("Cut unclosable frame at wheel %lu", ic);
+			pop_frame();
+
+			// Each cut counts as a step, so that callbacks that never
+			// run out of pieces will still halt.
+			if (not _cb->step(_frame))
+			{
+				_halts++;
+				to_sect = Handle::UNDEFINED;
+				continue;
+			}
+			to_sect = select(ic);
 		}
 
 		did_step = true;
-		push_frame();
-		_frame._wheel = ic;
-
-		// Connect it up, and get the newly-connected section.
-		HandlePair hpr = connect_section(fm_sect, offset, to_sect, to_con);
 
 		// Replace the from-section with the now-connected section.
-		for (size_t in = 0; in < _odo._size; in++)
-		{
-			if (*_odo._sections[in] == *fm_sect) _odo._sections[in] = hpr.first;
-			if (*_odo._sections[in] == *to_sect) _odo._sections[in] = hpr.second;
-		}
+		// If the to-section was already open, it has a slot, too.
+		set_slot(_odo._slot[ic], hpr.first);
+		auto sit = _odo._slot_of.find(to_sect);
+		if (_odo._slot_of.end() != sit) set_slot(sit->second, hpr.second);
 	}
 
 	if (not did_step)
@@ -276,7 +919,7 @@ bool Aggregate::do_step(void)
 
 	// If we found a solution, let the callback accumulate it.
 	if (0 == _frame._open_sections.size())
-		_cb->solution(_frame);
+		emit();
 
 	return true;
 }
@@ -287,6 +930,7 @@ bool Aggregate::step_odometer(void)
 	{
 		logger().fine("Odometer halted at frame depth=%lu odo stack=%lu",
 			_frame_stack.size(), _odo_stack.size());
+		_halts++;
 		return false;
 	}
 
@@ -311,6 +955,154 @@ bool Aggregate::step_odometer(void)
 	return did_step;
 }
 
+/// Ask the callback for a piece to attach to wheel `ic`, skipping
+/// the pieces that the constraints refuse.
+Handle Aggregate::select(size_t ic)
+{
+	const Handle& fm_sect = _odo.section(ic);
+	size_t offset = _odo._from_index[ic];
+	const Handle& to_con = _odo._to_connectors[ic];
+
+	const Handle& fm_con = fm_sect->getOutgoingAtom(1)->getOutgoingAtom(offset);
+	if (at_limit(_frame, fm_con))
+	{
+		logger().fine("Link limit: cannot connect wheel %lu", ic);
+		return Handle::UNDEFINED;
+	}
+
+	Handle to_sect = _cb->select(_frame, fm_sect, offset, to_con);
+	while (nullptr != to_sect)
+	{
+		if (crosses(fm_sect, offset, to_sect, to_con))
+			logger().fine("Planarity: skip crossing link on wheel %lu", ic);
+		else if (opens_cycle(fm_sect, offset, to_sect, to_con))
+			logger().fine("Cycle: skip fresh piece on wheel %lu", ic);
+		else
+			break;
+
+		// Each skip counts as a step, so that callbacks that
+		// never run out of pieces will still halt.
+		if (not _cb->step(_frame))
+		{
+			_halts++;
+			return Handle::UNDEFINED;
+		}
+		to_sect = _cb->select(_frame, fm_sect, offset, to_con);
+	}
+	return to_sect;
+}
+
+/// Return true if linking `fm_sect` to `to_sect` would cross some
+/// link that is already in the drawing of the frame. Only checked if
+/// the callback asks for planar (or projective) networks.
+bool Aggregate::crosses(const Handle& fm_sect, size_t offset,
+                        const Handle& to_sect, const Handle& to_con)
+{
+	if (not _cb->planar and not _cb->projective) return false;
+
+	Embedding emb(_frame._embedding);
+	if (not _frame._open_sections.contains(to_sect))
+		emb.add_section(to_sect);
+	return not emb.link({fm_sect->getOutgoingAtom(0), offset},
+		{to_sect->getOutgoingAtom(0), con_index(to_sect, to_con)},
+		_cb->projective);
+}
+
+/// Return true if `to_sect` is a fresh piece, while the connector pair
+/// must close a cycle, and some open section could take the link.
+/// The open sections are checked against the same rules that the
+/// callbacks use: no self-connections, and no more links between
+/// a pair of sections than allowed.
+bool Aggregate::opens_cycle(const Handle& fm_sect, size_t offset,
+                            const Handle& to_sect, const Handle& to_con)
+{
+	if (_cb->must_close.empty()) return false;
+	if (_frame._open_sections.contains(to_sect)) return false;
+
+	const HandleSeq& fm_seq = fm_sect->getOutgoingAtom(1)->getOutgoingSet();
+	const Handle& fm_con = fm_seq[offset];
+	if (0 == _cb->must_close.count({fm_con, to_con}) and
+	    0 == _cb->must_close.count({to_con, fm_con}))
+		return false;
+
+	const Handle& linkty = to_con->getOutgoingAtom(0);
+	for (const Handle& open_sect : _frame._open_sections)
+	{
+		if (open_sect == fm_sect and not _cb->allow_self_connections)
+			continue;
+		if (not has_connector(open_sect, to_con)) continue;
+
+		// Links made between the two sections appear in both.
+		const HandleSeq& to_seq = open_sect->getOutgoingAtom(1)->getOutgoingSet();
+		size_t shared = 0;
+		for (const Handle& lnk : fm_seq)
+		{
+			if (CONNECTOR == lnk->get_type()) continue;
+			if (to_seq.end() != std::find(to_seq.begin(), to_seq.end(), lnk))
+				shared++;
+		}
+		if (_cb->pair_any_links <= shared) continue;
+		if (1 < _cb->pair_any_links and _cb->pair_typed_links <=
+		    _cb->num_links(fm_sect, open_sect, linkty))
+			continue;
+		return true;
+	}
+	return false;
+}
+
+/// Return true if the frame already has as many links of the type of
+/// `fm_con` as the callback allows.
+bool Aggregate::at_limit(const Frame& frm, const Handle& fm_con)
+{
+	if (_cb->link_limits.empty()) return false;
+
+	const Handle& linkty = fm_con->getOutgoingAtom(0);
+	auto lim = _cb->link_limits.find(linkty);
+	if (_cb->link_limits.end() == lim) return false;
+	return lim->second <= frm._link_counts.get(linkty, 0);
+}
+
+/// Return true if the link limits leave too few links to close all
+/// of the open connectors. Each link closes at most two of them.
+bool Aggregate::over_limits(void)
+{
+	for (const auto& lim : _cb->link_limits)
+	{
+		size_t open = 0;
+		for (const auto& pr : _frame._open_cons)
+			if (*pr.first->getOutgoingAtom(0) == *lim.first)
+				open += pr.second;
+		if (0 == open) continue;
+
+		size_t used = _frame._link_counts.get(lim.first, 0);
+		if (lim.second < used + (open + 1) / 2) return true;
+	}
+	return false;
+}
+
+/// Return true if the current frame can never be completed: either
+/// some open connector can never be closed, or closing them all would
+/// need more sections, or more links of some type, than the callback
+/// allows.
+bool Aggregate::unclosable(void)
+{
+	size_t need = _cb->min_to_close(_frame);
+	if (SIZE_MAX == need) return true;
+	if (over_limits()) return true;
+
+	size_t have = _frame._linkage.size() + _frame._open_sections.size();
+	if (have + need <= _cb->max_network_size) return false;
+
+	// While deepening, the limit is only temporary; the frames above
+	// this one must not be recorded as fully explored.
+	if (_deepening)
+	{
+		_limit_cuts++;
+		_halts++;
+	}
+	return true;
+}
+
 #define al _as->add_link
 #define an _as->add_node
 
@@ -337,15 +1129,24 @@ HandlePair Aggregate::connect_section(const Handle& fm_sect,
 	const Handle& fm_con = conseq->getOutgoingAtom(offset);
 
 	Handle link = _cb->make_link(fm_con, to_con, fm_point, to_point);
+	_frame._hash += Shape::link_key(link);
 
-	// Oh dear, we need the index of the to_con in the to_sect
-	// Perhaps the callback should provide this info?
-	const Handle& disj = to_sect->getOutgoingAtom(1);
-	const HandleSeq& tseq = disj->getOutgoingSet();
-	size_t tidx = -1;
-	for (size_t i=0; i<tseq.size(); i++)
+	// Count the links of each limited type.
+	if (not _cb->link_limits.empty())
 	{
-		if (*to_con == *tseq[i]) { tidx = i; break; }
+		const Handle& linkty = fm_con->getOutgoingAtom(0);
+		_frame._link_counts.set(linkty, _frame._link_counts.get(linkty, 0) + 1);
+	}
+
+	size_t tidx = con_index(to_sect, to_con);
+
+	// Draw the link, too, if it is being drawn.
+	if (_cb->planar or _cb->projective)
+	{
+		if (not _frame._open_sections.contains(to_sect))
+			_frame._embedding.add_section(to_sect);
+		_frame._embedding.link({fm_point, offset}, {to_point, tidx},
+		                       _cb->projective);
 	}
 
 	Handle new_fm = make_link(fm_sect, offset, link);
@@ -353,6 +1154,25 @@ HandlePair Aggregate::connect_section(const Handle& fm_sect,
 	return HandlePair(new_fm, new_to);
 }
 
+/// Oh dear, we need the index of the to_con in the to_sect
+/// Perhaps the callback should provide this info? The connectors
+/// are shared by all sections, so compare pointers; fall back to
+/// comparing contents only if that fails.
+size_t Aggregate::con_index(const Handle& to_sect, const Handle& to_con)
+{
+	const Handle& disj = to_sect->getOutgoingAtom(1);
+	const HandleSeq& tseq = disj->getOutgoingSet();
+	for (size_t i=0; i<tseq.size(); i++)
+	{
+		if (to_con == tseq[i]) return i;
+	}
+	for (size_t i=0; i<tseq.size(); i++)
+	{
+		if (*to_con == *tseq[i]) return i;
+	}
+	return -1;
+}
+
 /// Create a link.  That is, replace a connector `con` by `link` in
 /// the section `sect`. Then update the aggregation state. The section
 /// is removed from the set of open sections. If the new linked section
@@ -388,8 +1208,23 @@ Handle Aggregate::make_link(const Handle& sect, size_t index,
 		_scratch->add_link(SECTION, point,
 			_scratch->add_link(CONNECTOR_SEQ, std::move(oset)));
 
-	// Remove the section from the open set.
-	_frame._open_sections.erase(sect);
+	// Remove the section from the open set. If it was not in the
+	// open set, then it is a fresh piece, and all of its other
+	// connectors are now open.
+	if (_frame._open_sections.erase(sect))
+	{
+		_cb->close_section(sect);
+		_frame._hash -= Shape::section_key(sect);
+		_frame.close_connector(disj->getOutgoingAtom(index));
+	}
+	else
+	{
+		const HandleSeq& conseq = disj->getOutgoingSet();
+		for (size_t i = 0; i < conseq.size(); i++)
+			if (i != index and CONNECTOR == conseq[i]->get_type())
+				_frame.open_connector(conseq[i]);
+	}
+	_frame._hash += Shape::section_key(linking);
 
 	// If the connected section has remaining unconnected connectors,
 	// then add it to the unfinished set. Else we are done with it.
@@ -397,13 +1232,16 @@ Handle Aggregate::make_link(const Handle& sect, size_t index,
 	{
 		_frame._open_sections.insert(linking);
 		_frame._open_points.insert(point);
-		logger().fine("---- Open point %s", point->to_string().c_str());
+		_cb->open_section(linking);
+		if (logger().is_fine_enabled())
+			logger().fine("---- Open point %s", point->to_string().c_str());
 	}
 	else
 	{
 		_frame._linkage.insert(linking);
 		_frame._open_points.erase(point);
-		logger().fine("---- Close point %s", point->to_string().c_str());
+		if (logger().is_fine_enabled())
+			logger().fine("---- Close point %s", point->to_string().c_str());
 	}
 
 	return linking;
@@ -413,7 +1251,7 @@ void Aggregate::push_frame(void)
 {
 	_cb->push_frame(_frame);
 	_frame_stack.push(_frame);
-	_odo_sections.push(_odo._sections);
+	_slot_marks.push(_slot_trail.size());
 	_frame._nodo = _odo_stack.size();
 	_frame._wheel = -1;
 
@@ -425,8 +1263,17 @@ void Aggregate::push_frame(void)
 void Aggregate::pop_frame(void)
 {
 	_cb->pop_frame(_frame);
-	_frame = _frame_stack.top(); _frame_stack.pop();
-	_odo._sections = _odo_sections.top(); _odo_sections.pop();
+	_frame = std::move(_frame_stack.top()); _frame_stack.pop();
+	// Undo the slot changes made in this frame.
+	size_t mark = _slot_marks.top(); _slot_marks.pop();
+	while (mark < _slot_trail.size())
+	{
+		const auto& chg = _slot_trail.back();
+		_odo._slot_of.erase(_odo._sections[chg.first]);
+		_odo._sections[chg.first] = chg.second;
+		_odo._slot_of[chg.second] = chg.first;
+		_slot_trail.pop_back();
+	}
 
 	logger().fine("---- Pop: Frame stack depth now %lu npts=%lu open=%lu lkg=%lu",
 	     _frame_stack.size(), _frame._open_points.size(),
@@ -434,6 +1281,17 @@ void Aggregate::pop_frame(void)
 	_frame.print();
 }
 
+/// Place the section `sect` into odometer slot `slot`, remembering
+/// the old section, so that the change can be undone.
+void Aggregate::set_slot(size_t slot, const Handle& sect)
+{
+	const Handle& old = _odo._sections[slot];
+	_slot_trail.push_back({slot, old});
+	_odo._slot_of.erase(old);
+	_odo._sections[slot] = sect;
+	_odo._slot_of[sect] = slot;
+}
+
 /// Push the odometer state.
 void Aggregate::push_odo(void)
 {
@@ -451,7 +1309,7 @@ void Aggregate::pop_odo(void)
 	while (_odo._frame_depth < _frame_stack.size()) pop_frame();
 
 	_cb->pop_odometer(_odo);
-	_odo = _odo_stack.top(); _odo_stack.pop();
+	_odo = std::move(_odo_stack.top()); _odo_stack.pop();
 
 	logger().fine("==== Pop: Odo stack depth now %lu", _odo_stack.size());
 }
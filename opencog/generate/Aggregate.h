@@ -22,11 +22,17 @@
 #ifndef _OPENCOG_AGGREGATE_H
 #define _OPENCOG_AGGREGATE_H
 
+#include <atomic>
+#include <future>
+#include <memory>
 #include <set>
+#include <unordered_map>
+#include <vector>
 
 #include <opencog/atomspace/AtomSpace.h>
 #include <opencog/generate/Frame.h>
 #include <opencog/generate/GenerateCallback.h>
+#include <opencog/generate/Shape.h>
 
 namespace opencog
 {
@@ -48,10 +54,15 @@ private:
 	Odometer _odo;
 
 	std::stack<Frame> _frame_stack;
-	std::stack<HandleSeq> _odo_sections;
 	void push_frame();
 	void pop_frame();
 
+	/// Changes made to the odometer slots, so that they can be undone
+	/// when the frame is popped: the slot, and the section it held.
+	std::vector<std::pair<size_t, Handle>> _slot_trail;
+	std::stack<size_t> _slot_marks;
+	void set_slot(size_t, const Handle&);
+
 	std::stack<Odometer> _odo_stack;
 	void push_odo();
 	void pop_odo();
@@ -62,10 +73,81 @@ private:
 	bool step_odometer(void);
 	bool do_step(void);
 
-	void recurse(void);
+	void add_open(const Handle&);
+	void search(void);
+	void emit(void);
 
+	/// When extending a network: its complete sections, which take no
+	/// part in the search, and the points of its open sections, which
+	/// are not interchangeable with others of the same name, as they
+	/// are joined to the rest of the network.
+	HandleSeq _fixed;
+	HandleSet _pinned;
+
+	void recurse(void);
+	void recurse_depth(void);
+	void deepen(void);
+	void meet(void);
+	std::vector<Frame> join(const std::vector<Frame>&,
+	                        const std::vector<Frame>&);
+	void install(const Frame&);
+	bool pick_connector(Handle&, size_t&, HandleSeq&);
+	void report(void);
+
+	/// While growing out from a single nucleus, the partial assemblies
+	/// are kept here, and the growth stops at this distance.
+	std::vector<Frame>* _parts;
+	size_t _radius;
+
+	/// Transposition table: frames that have been fully explored.
+	/// This is a ring buffer of `max_transpositions` entries, indexed
+	/// by the frame hash. Each entry keeps the (structurally shared)
+	/// sections of the frame; its shape is only worked out when some
+	/// other frame with the same hash is looked up.
+	struct Explored
+	{
+		size_t hash;
+		PersistentHandleSet linkage;
+		PersistentHandleSet open;
+		std::unique_ptr<Shape> shape;
+	};
+	std::vector<Explored> _explored;
+	std::unordered_multimap<size_t, size_t> _explored_index;
+	size_t _explored_next;
+
+	/// Number of times that exploration was halted by the callback.
+	/// A frame is fully explored if this does not change.
+	size_t _halts;
+
+	/// Number of frames cut because they would grow past the network
+	/// size limit, while deepening. Only solutions of at least
+	/// `_report_from` sections are reported; smaller ones were found
+	/// by earlier iterations.
+	bool _deepening;
+	size_t _limit_cuts;
+	size_t _report_from;
+
+	/// Set by `cancel()`; halts the search as soon as it is noticed.
+	/// Cleared when a new run is started.
+	std::atomic<bool> _cancel;
+
+	void do_aggregate(const HandleSet&, GenerateCallback&);
+
+	Shape frame_shape(const PersistentHandleSet&,
+	                  const PersistentHandleSet&) const;
+	bool was_explored(void);
+	void set_explored(void);
+
+	Handle select(size_t);
+	bool unclosable(void);
+	bool at_limit(const Frame&, const Handle&);
+	bool over_limits(void);
+
+	bool crosses(const Handle&, size_t, const Handle&, const Handle&);
+	bool opens_cycle(const Handle&, size_t, const Handle&, const Handle&);
 	HandlePair connect_section(const Handle&, size_t,
 	                           const Handle&, const Handle&);
+	static size_t con_index(const Handle&, const Handle&);
 	Handle make_link(const Handle&, size_t, const Handle&);
 
 public:
@@ -73,6 +155,9 @@ public:
 	~Aggregate();
 
 	void aggregate(const HandleSet&, GenerateCallback&);
+	std::future<Handle> aggregate_async(const HandleSet&, GenerateCallback&);
+	void extend(const HandleSet&, GenerateCallback&);
+	void cancel(void) { _cancel = true; }
 
 };
 
@@ -18,6 +18,7 @@
  */
 
 #include <stdio.h>
+#include <cmath>
 
 #include "BasicParameters.h"
 
@@ -27,26 +28,52 @@ BasicParameters::BasicParameters()
 {
 	// Try to close existing connectors .. sometimes.
 	close_fraction = 0.3;
+
+	// Never give up.
+	restart_policy = NO_RESTART;
+	restart_steps = 100;
+	restart_growth = 1.5;
 }
 
 BasicParameters::~BasicParameters()
 {}
 
-static std::random_device seed;
-static std::mt19937 rangen(seed());
+double BasicParameters::connect_existing(const Frame& frm, size_t max_size)
+{
+	return close_fraction;
+}
 
-static inline double uniform_double(void)
+bool BasicParameters::step(const Frame& frm)
 {
-   static std::uniform_real_distribution<> dist(0.0, 1.0);
-   return dist(rangen);
+	return true;
 }
 
-bool BasicParameters::connect_existing(const Frame& frm)
+/// The Luby sequence 1,1,2,1,1,2,4,1,1,2,1,1,2,4,8,... counting from
+/// one. Within a constant factor, this is the optimal restart schedule
+/// for a search with an unknown run-time distribution.
+static size_t luby(size_t i)
 {
-	return uniform_double() < close_fraction;
+	size_t k = 1;
+	while (((size_t) 1 << k) - 1 < i) k++;
+	if (((size_t) 1 << k) - 1 == i) return (size_t) 1 << (k-1);
+	return luby(i - ((size_t) 1 << (k-1)) + 1);
 }
 
-bool BasicParameters::step(const Frame& frm)
+size_t BasicParameters::attempt_steps(size_t attempt)
 {
-	return true;
+	switch (restart_policy)
+	{
+		case FIXED_RESTART:
+			return restart_steps;
+		case LUBY_RESTART:
+			return restart_steps * luby(attempt + 1);
+		case GEOMETRIC_RESTART:
+		{
+			double steps = restart_steps * std::pow(restart_growth, attempt);
+			if ((double) SIZE_MAX <= steps) return SIZE_MAX;
+			return steps;
+		}
+		default:
+			return SIZE_MAX;
+	}
 }
@@ -22,7 +22,6 @@
 #ifndef _OPENCOG_BASIC_PARAMETERS_H
 #define _OPENCOG_BASIC_PARAMETERS_H
 
-#include <random>
 #include <opencog/generate/RandomParameters.h>
 
 namespace opencog
@@ -42,8 +41,9 @@ public:
 	BasicParameters();
 	virtual ~BasicParameters();
 
-	virtual bool connect_existing(const Frame&);
+	virtual double connect_existing(const Frame&, size_t);
 	virtual bool step(const Frame&);
+	virtual size_t attempt_steps(size_t);
 
 	/// Fraction of the time that an attempt should be made to join
 	/// together two existing open connectors, if that is possible.
@@ -53,6 +53,25 @@ public:
 	/// piece is selected from the lexis (thus necessarily enlarging
 	/// the network.)
 	double close_fraction;
+
+	/// Restart policy. How many steps to spend on each root, before
+	/// abandoning it and drawing a fresh one.
+	/// NO_RESTART: never give up on a root.
+	/// FIXED_RESTART: give up after `restart_steps`.
+	/// LUBY_RESTART: give up after `restart_steps` times the Luby
+	///     sequence 1,1,2,1,1,2,4,1,1,2,1,1,2,4,8,...
+	/// GEOMETRIC_RESTART: give up after `restart_steps` times
+	///     `restart_growth` to the power of the attempt number.
+	enum RestartPolicy
+	{
+		NO_RESTART,
+		FIXED_RESTART,
+		LUBY_RESTART,
+		GEOMETRIC_RESTART
+	};
+	RestartPolicy restart_policy;
+	size_t restart_steps;
+	double restart_growth;
 };
 
 
@@ -0,0 +1,102 @@
+/*
+ * opencog/generate/BoundedQueue.h
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_BOUNDED_QUEUE_H
+#define _OPENCOG_BOUNDED_QUEUE_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+namespace opencog
+{
+/** \addtogroup grp_generate
+ *  @{
+ */
+
+/// Queue holding at most a fixed number of items, connecting threads
+/// that produce items to threads that consume them. Producers wait
+/// while the queue is full, and consumers wait while it is empty; thus
+/// a slow consumer holds up the producers. Items are moved in and out,
+/// never copied.
+///
+/// Once the queue is closed, pushes fail, and pops fail as soon as the
+/// remaining items have been drained.
+template<typename T>
+class BoundedQueue
+{
+private:
+	std::deque<T> _items;
+	size_t _capacity;
+	bool _closed;
+	std::mutex _mtx;
+	std::condition_variable _not_full;
+	std::condition_variable _not_empty;
+
+public:
+	BoundedQueue(size_t capacity) :
+		_capacity(0 < capacity ? capacity : 1), _closed(false) {}
+
+	/// Wait for room, and add the item. Returns false if the queue
+	/// was closed; the item is then dropped.
+	bool push(T&& item)
+	{
+		std::unique_lock<std::mutex> lck(_mtx);
+		_not_full.wait(lck, [this] {
+			return _closed or _items.size() < _capacity; });
+		if (_closed) return false;
+		_items.emplace_back(std::move(item));
+		lck.unlock();
+		_not_empty.notify_one();
+		return true;
+	}
+
+	/// Wait for an item, and remove it. Returns false if the queue
+	/// is closed and empty.
+	bool pop(T& item)
+	{
+		std::unique_lock<std::mutex> lck(_mtx);
+		_not_empty.wait(lck, [this] {
+			return _closed or not _items.empty(); });
+		if (_items.empty()) return false;
+		item = std::move(_items.front());
+		_items.pop_front();
+		lck.unlock();
+		_not_full.notify_one();
+		return true;
+	}
+
+	void close(void)
+	{
+		{
+			std::lock_guard<std::mutex> lck(_mtx);
+			_closed = true;
+		}
+		_not_full.notify_all();
+		_not_empty.notify_all();
+	}
+};
+
+
+/** @}*/
+}  // namespace opencog
+
+#endif // _OPENCOG_BOUNDED_QUEUE_H
@@ -19,56 +19,155 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
+
 #include <opencog/atoms/base/Link.h>
+#include <opencog/atoms/base/Node.h>
+#include <opencog/atoms/value/FloatValue.h>
 
 #include "CollectStyle.h"
 
 using namespace opencog;
 
-CollectStyle::CollectStyle(void)
+CollectStyle::CollectStyle(void) :
+	_isomorphic(false), _collector(nullptr), _num_streamed(0)
 {
 }
 
 CollectStyle::~CollectStyle() {}
 
+void CollectStyle::clear(void)
+{
+	_solutions.clear();
+	_shapes.clear();
+	_shape_count.clear();
+	_streamed.clear();
+	_num_streamed = 0;
+}
+
 /// In this "style" of recording a result, we just tack it onto
 /// a C++ container holding the solutions. Other "styles" are
 /// possible; we could report them elsewehre, too...
+///
+/// If `_isomorphic` is set, then solutions having the same shape
+/// as an earlier solution are counted, but are not recorded.
+///
+/// The linkage is converted to a HandleSet just once, and that is
+/// moved into place; the shape table points at it, instead of keeping
+/// copies.
 void CollectStyle::record_solution(const Frame& frm)
 {
-	size_t nsolns = _solutions.size();
-	_solutions.insert(frm._linkage);
-	size_t news = _solutions.size();
+	HandleSet linkage(frm._linkage.begin(), frm._linkage.end());
+
+	static const HandleSet none;
+	Shape shape(_isomorphic ? linkage : none);
+	if (_isomorphic)
+	{
+		auto range = _shapes.equal_range(shape.hash());
+		for (auto it = range.first; it != range.second; it++)
+		{
+			if (not (it->second.first == shape)) continue;
+
+			size_t cnt = 0;
+			if (it->second.second)
+				cnt = ++_shape_count[it->second.second];
+			logger().fine("Rediscovered shape, seen %lu times, size=%lu",
+			        cnt, frm._linkage.size());
+			return;
+		}
+	}
+
+	if (_collector) _collector->insert(linkage);
+
+	if (_stream)
+	{
+		// A solution of a new shape is surely new; otherwise, it is
+		// compared exactly to the earlier ones with the same hash.
+		if (_isomorphic)
+		{
+			_shapes.emplace(shape.hash(),
+				std::make_pair(std::move(shape), nullptr));
+		}
+		else
+		{
+			// The set is already sorted; a plain vector of the same
+			// sections is all that is needed to compare.
+			size_t hash = SolutionCollector::hash(linkage);
+			auto range = _streamed.equal_range(hash);
+			for (auto it = range.first; it != range.second; it++)
+			{
+				if (not std::equal(it->second.begin(), it->second.end(),
+				                   linkage.begin(), linkage.end())) continue;
+				logger().fine("Rediscovered streamed solution, size=%lu",
+				        frm._linkage.size());
+				return;
+			}
+			_streamed.emplace(hash, HandleSeq(linkage.begin(), linkage.end()));
+		}
+		_num_streamed++;
+		logger().fine("Streaming solution %lu of size %lu",
+		        _num_streamed, frm._linkage.size());
+		_stream(std::move(linkage));
+		return;
+	}
+
+	auto ins = _solutions.insert(std::move(linkage));
 	logger().fine("====================================");
-	if (nsolns != news)
+	if (ins.second)
 	{
+		if (_isomorphic)
+		{
+			const HandleSet* soln = &*ins.first;
+			_shapes.emplace(shape.hash(),
+				std::make_pair(std::move(shape), soln));
+			_shape_count[soln] = 1;
+		}
+
 		logger().fine("Obtained new solution %lu of size %lu:",
-		       news, frm._linkage.size());
+		       _solutions.size(), frm._linkage.size());
 		for (const Handle& lkg : frm._linkage)
 			frm.print_section(lkg);
 	}
 	else
 	{
 		logger().fine("Rediscovered solution, still have %lu size=%lu",
-		        news, frm._linkage.size());
+		        _solutions.size(), frm._linkage.size());
 	}
 	logger().fine("====================================");
 }
 
+/// Return the number of times that the solution `soln`, or a solution
+/// with the same shape, was found. Returns zero if `soln` was not
+/// recorded, or if shapes are not being tracked.
+size_t CollectStyle::shape_count(const HandleSet& soln)
+{
+	auto sit = _solutions.find(soln);
+	if (_solutions.end() == sit) return 0;
+
+	auto cit = _shape_count.find(&*sit);
+	if (_shape_count.end() == cit) return 0;
+	return cit->second;
+}
+
 /// XXX FIXME ... maybe should attach to a MemberLink or something?
 /// This obviously fails to scale if the section is large.
 /// That would be considered to be a different "style" and would
 /// almost surely be better than using SetLinks...
 Handle CollectStyle::get_solutions(void)
 {
+	static Handle shape_key(createNode(PREDICATE_NODE, "*-shape-count-*"));
+
 	HandleSeq solns;
-	for (const auto& sol : _solutions)
+	solns.reserve(_solutions.size());
+	for (const HandleSet& sol : _solutions)
 	{
-		HandleSeq sects;
-		for (const Handle& sect : sol)
-			sects.push_back(sect);
+		Handle setl(createLink(HandleSeq(sol.begin(), sol.end()), SET_LINK));
 
-		solns.push_back(createLink(std::move(sects), SET_LINK));
+		// Attach the number of times this shape was seen.
+		if (_isomorphic)
+			setl->setValue(shape_key,
+				createFloatValue((double) _shape_count[&sol]));
+		solns.push_back(setl);
 	}
 	return createLink(std::move(solns), SET_LINK);
 }
@@ -22,7 +22,13 @@
 #ifndef _OPENCOG_COLLECT_STYLE_H
 #define _OPENCOG_COLLECT_STYLE_H
 
+#include <functional>
+#include <unordered_map>
+
 #include <opencog/generate/Frame.h>
+#include <opencog/generate/GenerateCallback.h>
+#include <opencog/generate/Shape.h>
+#include <opencog/generate/SolutionCollector.h>
 
 namespace opencog
 {
@@ -39,16 +45,56 @@ protected:
 	/// Accumulated set of fully-grounded solutions.
 	std::set<HandleSet> _solutions;
 
+	/// If set, a solution is recorded only if its shape differs from
+	/// that of all of the solutions recorded so far. See `Shape`.
+	bool _isomorphic;
+
+	/// Shapes seen so far, keyed by their hash, together with the
+	/// solution that was recorded for that shape. The solution is
+	/// pointed at, in `_solutions`, rather than copied. (It is null
+	/// for streamed solutions, which are not kept.)
+	std::unordered_multimap<size_t,
+		std::pair<Shape, const HandleSet*>> _shapes;
+
+	/// Number of times that each recorded solution (or a solution
+	/// isomorphic to it) was found.
+	std::unordered_map<const HandleSet*, size_t> _shape_count;
+
+	/// If set, solutions are also recorded here, and the solution
+	/// count is the number of solutions recorded by all of the
+	/// threads that share it.
+	SolutionCollector* _collector;
+
+	/// If set, each new solution is handed over to this, as soon as it
+	/// is found, instead of being kept in `_solutions`. To tell new
+	/// solutions from rediscovered ones, the sorted sections of each
+	/// are kept, keyed by their hash. (If shapes are being tracked,
+	/// `_shapes` already does this.)
+	std::function<void(HandleSet&&)> _stream;
+	std::unordered_multimap<size_t, HandleSeq> _streamed;
+	size_t _num_streamed;
+
 public:
 	CollectStyle(void);
 	~CollectStyle();
 
-	void clear(void) { _solutions.clear(); }
+	void clear(void);
 	void record_solution(const Frame&);
+	size_t shape_count(const HandleSet&);
 
-	size_t num_solutions(void) { return _solutions.size(); }
-	std::set<HandleSet> get_solution_set(void) { return _solutions; }
+	size_t num_solutions(void) {
+		if (_collector) return _collector->size();
+		return _solutions.size() + _num_streamed;
+	}
 	Handle get_solutions(void);
+
+	/// The recorded solutions, without copying them.
+	const std::set<HandleSet>& get_solution_set(void) const {
+		return _solutions;
+	}
+	void visit_solutions(const SolutionVisitor& visit) const {
+		for (const HandleSet& soln : _solutions) visit(soln);
+	}
 };
 
 
@@ -29,7 +29,7 @@
 using namespace opencog;
 
 Dictionary::Dictionary(AtomSpace* as)
-	: _as(as)
+	: _as(as), _max_arity(0)
 {}
 
 // ===============================================================
@@ -39,11 +39,15 @@ void Dictionary::add_pole_pair(const Handle& fm_pole,
                                const Handle& to_pole)
 {
 	_pole_pairs.push_back({fm_pole, to_pole});
+
+	// The joints already found may have changed.
+	for (auto& pr : _joints)
+		pr.second = find_joints(pr.first);
 }
 
 /// Given the Connector `from_con`, return a list of Connectors
 /// that it can attach to.
-HandleSeq Dictionary::joints(const Handle& from_con) const
+HandleSeq Dictionary::find_joints(const Handle& from_con) const
 {
 	HandleSeq phs;
 
@@ -52,26 +56,55 @@ HandleSeq Dictionary::joints(const Handle& from_con) const
 	// Or at least throwing.
 	if (CONNECTOR != from_con->get_type()) return phs;
 
-	// Assume only one pole per connector.
-	Handle from_pole = from_con->getOutgoingAtom(1);
-	Handle to_pole;
-	for (const HandlePair& popr: _pole_pairs)
-		if (from_pole == popr.first) { to_pole = popr.second; break; }
-
-	// A matching pole was not found.
-	if (!to_pole) return phs;
-
 	// Link type of the desired link to make...
+	Handle from_pole = from_con->getOutgoingAtom(1);
 	Handle linkty = from_con->getOutgoingAtom(0);
 
-	// Find appropriate connector, if it exists.
-	Handle matching = _as->get_atom(createLink(CONNECTOR, linkty, to_pole));
-	if (matching)
+	// A pole may pair with several others; each gives a joint, in
+	// the order in which the pole pairs were added. Unordered pairs
+	// are added in both directions, so skip repeats.
+	for (const HandlePair& popr: _pole_pairs)
+	{
+		if (from_pole != popr.first) continue;
+
+		// Find appropriate connector, if it exists.
+		Handle matching = _as->get_atom(createLink(CONNECTOR, linkty, popr.second));
+		if (nullptr == matching) continue;
+		if (phs.end() != std::find(phs.begin(), phs.end(), matching)) continue;
 		phs.push_back(matching);
+	}
 
 	return phs;
 }
 
+/// Record the joints of the Connector `con`, and refresh those of
+/// the connectors that can joint to it, in case `con` is new.
+void Dictionary::add_joints(const Handle& con)
+{
+	if (CONNECTOR != con->get_type()) return;
+
+	_joints[con] = find_joints(con);
+	for (const Handle& mate : _joints[con])
+	{
+		auto jit = _joints.find(mate);
+		if (_joints.end() != jit)
+			jit->second = find_joints(mate);
+	}
+}
+
+/// Given the Connector `from_con`, return a list of Connectors
+/// that it can attach to. Only the connectors in the lexis are
+/// known; any other connector has no joints.
+const HandleSeq& Dictionary::joints(const Handle& from_con) const
+{
+	static HandleSeq empty;
+
+	const auto& jit = _joints.find(from_con);
+	if (_joints.end() == jit) return empty;
+
+	return jit->second;
+}
+
 // ===============================================================
 // Section stuff.
 
@@ -101,8 +134,11 @@ void Dictionary::add_to_lexis(const Handle& sect)
 	// and (2) the sequence can be ordered in priority order.
 	//
 	Handle con_seq = sect->getOutgoingAtom(1);
+	_max_arity = std::max(_max_arity, con_seq->get_arity());
 	for (const Handle& con : con_seq->getOutgoingSet())
 	{
+		add_joints(con);
+
 		HandleSeq sect_list = _connectables[con];
 
 		// Only allow unique entries
@@ -169,3 +205,43 @@ const HandleSeq& Dictionary::entries(const Handle& point) const
 
 	return ice->second;
 }
+
+// ===============================================================
+// Feasibility.
+
+/// Return a lower bound on the number of sections that must be added
+/// to a network, in order to close all of the unconnected connectors
+/// counted in `open`. Return SIZE_MAX if some of them can never be
+/// closed.
+///
+/// An open connector can be closed by another open connector, or by
+/// a new section. For each kind of connector, the number of open mates
+/// bounds how many can be closed without new sections; the rest must
+/// go to new sections, each of which has at most `_max_arity`
+/// connectors. If no section in the lexis can take them, then they
+/// can never be closed.
+size_t Dictionary::min_to_close(const PersistentHandleCounter& open) const
+{
+	size_t unmatched = 0;
+	for (const auto& pr : open)
+	{
+		const Handle& con = pr.first;
+		size_t num = pr.second;
+
+		size_t supply = 0;
+		bool absorbable = false;
+		for (const Handle& mate : joints(con))
+		{
+			if (*mate == *con) supply += num - 1;
+			else supply += open.get(mate, 0);
+
+			if (0 < connectables(mate).size()) absorbable = true;
+		}
+		if (num <= supply) continue;
+		if (not absorbable) return SIZE_MAX;
+		unmatched += num - supply;
+	}
+
+	if (0 == unmatched) return 0;
+	return (unmatched + _max_arity - 1) / _max_arity;
+}
@@ -23,6 +23,7 @@
 #define _OPENCOG_DICTIONARY_H
 
 #include <opencog/atomspace/AtomSpace.h>
+#include <opencog/generate/Frame.h>
 
 namespace opencog
 {
@@ -59,12 +60,22 @@ class Dictionary
 	/// This map is set up at the start, before iteration begins.
 	HandleSeqMap _entries;
 
+	/// Map from the Connectors in the lexis to the Connectors that
+	/// they can joint to. Kept up to date as poles and sections are
+	/// added, so that looking up the joints copies nothing.
+	HandleSeqMap _joints;
+	HandleSeq find_joints(const Handle&) const;
+	void add_joints(const Handle&);
+
+	/// The largest number of connectors on any section.
+	size_t _max_arity;
+
 public:
 	Dictionary(AtomSpace*);
 
 	void add_pole_pair(const Handle&, const Handle&);
 
-	HandleSeq joints(const Handle&) const;
+	const HandleSeq& joints(const Handle&) const;
 
 	void add_to_lexis(const Handle&);
 	void add_to_lexis(const HandleSet& lex) {
@@ -74,6 +85,8 @@ public:
 
 	const HandleSeq& connectables(const Handle&) const;
 	const HandleSeq& entries(const Handle&) const;
+
+	size_t min_to_close(const PersistentHandleCounter&) const;
 };
 
 
@@ -0,0 +1,257 @@
+/*
+ * opencog/generate/Embedding.cc
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <atomic>
+
+#include <opencog/atoms/base/Link.h>
+
+#include "Embedding.h"
+
+using namespace opencog;
+
+/// Face labels are unique across all drawings, so that drawings made
+/// separately (e.g. when meeting in the middle) can be merged.
+size_t Embedding::new_face(void)
+{
+	static std::atomic<size_t> next_face(0);
+	return next_face++;
+}
+
+void Embedding::clear(void)
+{
+	_rot.clear();
+	_piece_size.clear();
+	_bottoms.clear();
+}
+
+const Embedding::Rotation& Embedding::rotation(const Handle& point) const
+{
+	static const Rotation none;
+	return _rot.get(point, none);
+}
+
+const Embedding::Corner& Embedding::next(const Corner& c) const
+{
+	return rotation(c.point).next[c.slot];
+}
+
+const Embedding::Corner& Embedding::prev(const Corner& c) const
+{
+	return rotation(c.point).prev[c.slot];
+}
+
+size_t Embedding::face(const Corner& c) const
+{
+	return rotation(c.point).face[c.slot];
+}
+
+bool Embedding::is_bottom(const Corner& c) const
+{
+	return c.slot + 1 == rotation(c.point).next.size();
+}
+
+void Embedding::set_next(const Corner& c, const Corner& n)
+{
+	Rotation rc(rotation(c.point));
+	rc.next[c.slot] = n;
+	_rot.set(c.point, rc);
+
+	Rotation rn(rotation(n.point));
+	rn.prev[n.slot] = c;
+	_rot.set(n.point, rn);
+}
+
+void Embedding::set_face(const Corner& c, size_t f)
+{
+	Rotation rc(rotation(c.point));
+	rc.face[c.slot] = f;
+	_rot.set(c.point, rc);
+}
+
+/// The new section is a face of its own: its bottom, followed by
+/// each of its unconnected connectors.
+void Embedding::add_section(const Handle& sect)
+{
+	const Handle& point = sect->getOutgoingAtom(0);
+	const HandleSeq& conseq = sect->getOutgoingAtom(1)->getOutgoingSet();
+	size_t bottom = conseq.size();
+
+	std::vector<size_t> ring;
+	ring.push_back(bottom);
+	for (size_t i = 0; i < conseq.size(); i++)
+		if (CONNECTOR == conseq[i]->get_type()) ring.push_back(i);
+
+	size_t f = new_face();
+	Rotation rot;
+	rot.next.resize(bottom + 1);
+	rot.prev.resize(bottom + 1);
+	rot.face.resize(bottom + 1, f);
+	rot.piece = point;
+	for (size_t i = 0; i < ring.size(); i++)
+	{
+		size_t nx = ring[(i + 1) % ring.size()];
+		rot.next[ring[i]] = {point, nx};
+		rot.prev[nx] = {point, ring[i]};
+	}
+	_rot.set(point, rot);
+	_piece_size.set(point, 1);
+	_bottoms.set(f, 1);
+}
+
+void Embedding::merge(const Embedding& other)
+{
+	for (const auto& pr : other._rot) _rot.set(pr.first, pr.second);
+	for (const auto& pr : other._piece_size) _piece_size.set(pr.first, pr.second);
+	for (const auto& pr : other._bottoms) _bottoms.set(pr.first, pr.second);
+}
+
+/// Walk the two stretches of face, `a0` to `a1` and `b0` to `b1`, in
+/// step, and return 0 if the first is no longer than the second, else
+/// 1. This costs twice the length of the shorter one.
+size_t Embedding::shorter(const Corner& a0, const Corner& a1,
+                          const Corner& b0, const Corner& b1) const
+{
+	Corner a(a0), b(b0);
+	while (true)
+	{
+		if (a == a1) return 0;
+		if (b == b1) return 1;
+		a = next(a);
+		b = next(b);
+	}
+}
+
+/// Put the face label `f` on the stretch of face from `c0` to `c1`.
+/// Returns the number of bottoms on it.
+size_t Embedding::relabel(const Corner& c0, const Corner& c1, size_t f)
+{
+	size_t nbot = 0;
+	Corner c(c0);
+	while (true)
+	{
+		set_face(c, f);
+		if (is_bottom(c)) nbot++;
+		if (c == c1) return nbot;
+		c = next(c);
+	}
+}
+
+/// Two pieces were joined; give them the label of the larger one.
+void Embedding::join_pieces(const Handle& pa, const Handle& pb)
+{
+	size_t na = _piece_size.get(pa, 0);
+	size_t nb = _piece_size.get(pb, 0);
+	const Handle& keep = (na < nb) ? pb : pa;
+	const Handle& gone = (na < nb) ? pa : pb;
+
+	// A piece with one point is labelled by that point. Larger pieces
+	// are rare (they come from several nuclei); just search for them.
+	HandleSeq points;
+	if (1 == _piece_size.get(gone, 0))
+		points.push_back(gone);
+	else
+		for (const auto& pr : _rot)
+			if (pr.second.piece == gone) points.push_back(pr.first);
+
+	for (const Handle& pt : points)
+	{
+		Rotation rot(rotation(pt));
+		rot.piece = keep;
+		_rot.set(pt, rot);
+	}
+	_piece_size.set(keep, na + nb);
+	_piece_size.erase(gone);
+}
+
+/// Link corners `a` and `b`. Removing them from their face (or faces),
+/// the face `a S1 b S2` splits into `S1` and `S2`, while the faces
+/// `a SA` and `b SB`, on different pieces, join into `SA SB`.
+bool Embedding::link(const Corner& a, const Corner& b, bool projective)
+{
+	size_t fa = face(a);
+	size_t fb = face(b);
+	Handle piece_a = rotation(a.point).piece;
+	Handle piece_b = rotation(b.point).piece;
+
+	// Different faces of the same piece: the link must cross some
+	// other link to get from the one to the other.
+	if (fa != fb and piece_a == piece_b) return false;
+
+	Corner pa(prev(a)), na(next(a));
+	Corner pb(prev(b)), nb(next(b));
+
+	if (fa == fb)
+	{
+		// Close up the two new faces, S1 from na to pb, and S2 from
+		// nb to pa. Either may be empty.
+		bool s1 = (na != b);
+		bool s2 = (nb != a);
+		if (s1) set_next(pb, na);
+		if (s2) set_next(pa, nb);
+		if (not s1 or not s2) return true;
+
+		// Move the shorter one to a new face.
+		size_t total = _bottoms.get(fa, 0);
+		size_t f = new_face();
+		size_t moved = (0 == shorter(na, pb, nb, pa)) ?
+			relabel(na, pb, f) : relabel(nb, pa, f);
+
+		// The bottoms can no longer all be lined up.
+		if (projective and 0 < moved and moved < total) return false;
+
+		_bottoms.set(f, moved);
+		_bottoms.set(fa, total - moved);
+		return true;
+	}
+
+	// Join SA, from na to pa, with SB, from nb to pb.
+	bool sa = (na != a);
+	bool sb = (nb != b);
+	if (sa and sb)
+	{
+		set_next(pa, nb);
+		set_next(pb, na);
+	}
+	else if (sa) set_next(pa, na);
+	else if (sb) set_next(pb, nb);
+
+	// Give the shorter one the label of the longer one.
+	size_t bot_a = _bottoms.get(fa, 0);
+	size_t bot_b = _bottoms.get(fb, 0);
+	size_t keep = fa;
+	if (sa and sb)
+	{
+		if (0 == shorter(na, pa, nb, pb)) { relabel(na, pa, fb); keep = fb; }
+		else relabel(nb, pb, fa);
+	}
+	else if (sa)
+		keep = fa;
+	else if (sb)
+		keep = fb;
+	_bottoms.erase(fa);
+	_bottoms.erase(fb);
+	_bottoms.set(keep, bot_a + bot_b);
+
+	join_pieces(piece_a, piece_b);
+	return true;
+}
+
+// ========================== END OF FILE ==========================
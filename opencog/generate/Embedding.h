@@ -0,0 +1,135 @@
+/*
+ * opencog/generate/Embedding.h
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_EMBEDDING_H
+#define _OPENCOG_EMBEDDING_H
+
+#include <vector>
+
+#include <opencog/atoms/base/Handle.h>
+#include <opencog/generate/PersistentMap.h>
+
+namespace opencog
+{
+/** \addtogroup grp_generate
+ *  @{
+ */
+
+/// Planar drawing of a partial assembly, kept up to date as links are
+/// added, so that links that cannot be drawn without crossings can be
+/// refused before they are made.
+///
+/// The connectors of each section are taken to be in clockwise order
+/// around the point, starting from the bottom of the point: for the
+/// dictionaries in the tests, that is the left-pointing connectors,
+/// nearest first, and then the right-pointing ones, farthest first.
+/// This is the order in which the links leave a word, when the words
+/// are written on a line and the links are drawn above it.
+///
+/// The drawing is kept as its faces: each face is the cycle of the
+/// unconnected connectors (and of the bottoms of the points) that can
+/// be reached without crossing a link. Two connectors can be linked
+/// without a crossing if they are on the same face (which the link
+/// then splits in two), or if they are on different, unconnected
+/// pieces (which the link then joins). The faces are labelled; a
+/// split relabels the smaller half, and a join the smaller face, so
+/// that each connector is relabelled only a logarithmic number of
+/// times, and each check is a label lookup.
+///
+/// If the drawing is to be projective (no crossings, with all of
+/// the points on a line, as in Link Grammar), then all of the bottoms
+/// must stay on one face: a link splitting the bottoms is refused.
+/// Whether the left and right pointing connectors end up on the
+/// correct sides is not checked.
+///
+/// Like the rest of the frame, this is persistent; copying it is
+/// cheap.
+class Embedding
+{
+public:
+	/// A corner: connector `slot` of the section at `point`. The slot
+	/// just past the last connector is the bottom of the point.
+	struct Corner
+	{
+		Handle point;
+		size_t slot;
+		bool operator==(const Corner& other) const {
+			return point == other.point and slot == other.slot;
+		}
+		bool operator!=(const Corner& other) const {
+			return not (*this == other);
+		}
+	};
+
+private:
+	/// The corners of one point; each vector is indexed by slot.
+	struct Rotation
+	{
+		std::vector<Corner> next;
+		std::vector<Corner> prev;
+		std::vector<size_t> face;
+		Handle piece;
+	};
+	PersistentMap<Handle, Rotation> _rot;
+
+	/// Number of points in each connected piece, by label.
+	PersistentMap<Handle, size_t> _piece_size;
+
+	/// Number of bottoms on each face, by label.
+	PersistentMap<size_t, size_t> _bottoms;
+
+	const Rotation& rotation(const Handle&) const;
+	const Corner& next(const Corner&) const;
+	const Corner& prev(const Corner&) const;
+	size_t face(const Corner&) const;
+	bool is_bottom(const Corner&) const;
+	void set_next(const Corner&, const Corner&);
+	void set_face(const Corner&, size_t);
+
+	size_t shorter(const Corner&, const Corner&,
+	               const Corner&, const Corner&) const;
+	size_t relabel(const Corner&, const Corner&, size_t);
+	void join_pieces(const Handle&, const Handle&);
+
+	static size_t new_face(void);
+
+public:
+	void clear(void);
+	bool empty(void) const { return _rot.empty(); }
+
+	/// Add a section, not yet linked to anything, as a piece of its own.
+	void add_section(const Handle& sect);
+
+	/// Add all of the pieces of another drawing; there must not be any
+	/// points in common.
+	void merge(const Embedding&);
+
+	/// Link two corners. Returns false, leaving the drawing in an
+	/// unspecified state, if this would cross some link (or, if
+	/// `projective`, leave some point off of the line). Check on a
+	/// copy, to keep the original.
+	bool link(const Corner&, const Corner&, bool projective);
+};
+
+/** @}*/
+}  // namespace opencog
+
+#endif // _OPENCOG_EMBEDDING_H
@@ -18,6 +18,7 @@
  */
 
 #include <stdio.h>
+#include <algorithm>
 
 #include <opencog/atoms/base/Handle.h>
 #include <opencog/atoms/base/Link.h>
@@ -32,13 +33,56 @@ void Frame::clear(void)
 	_open_points.clear();
 	_open_sections.clear();
 	_linkage.clear();
+	_hash = 0;
+	_open_cons.clear();
+	_link_counts.clear();
+	_distance.clear();
+	_embedding.clear();
+	_open_count = 0;
+	_reach = 0;
 	_nodo = -1;
 	_wheel = -1;
 }
 
+/// Add all of the sections, links and open connectors of `other`
+/// to this frame. The two frames must not share any points.
+void Frame::merge(const Frame& other)
+{
+	for (const Handle& pt : other._open_points) _open_points.insert(pt);
+	for (const Handle& sect : other._open_sections) _open_sections.insert(sect);
+	for (const Handle& lkg : other._linkage) _linkage.insert(lkg);
+	_hash += other._hash;
+	for (const auto& pr : other._open_cons)
+		_open_cons.set(pr.first, _open_cons.get(pr.first, 0) + pr.second);
+	_open_count += other._open_count;
+	for (const auto& pr : other._link_counts)
+		_link_counts.set(pr.first, _link_counts.get(pr.first, 0) + pr.second);
+	for (const auto& pr : other._distance)
+		_distance.set(pr.first, pr.second);
+	_reach = std::max(_reach, other._reach);
+	_embedding.merge(other._embedding);
+}
+
+void Frame::open_connector(const Handle& con)
+{
+	_open_cons.set(con, _open_cons.get(con, 0) + 1);
+	_open_count ++;
+}
+
+void Frame::close_connector(const Handle& con)
+{
+	size_t cnt = _open_cons.get(con, 0);
+	if (0 == cnt) return;
+	if (1 == cnt) _open_cons.erase(con);
+	else _open_cons.set(con, cnt - 1);
+	_open_count --;
+}
+
 void Odometer::clear(void)
 {
 	_sections.clear();
+	_slot.clear();
+	_slot_of.clear();
 	_from_index.clear();
 	_to_connectors.clear();
 	_size = 0;
@@ -50,9 +94,14 @@ void Odometer::clear(void)
 // Debug printing utilities.
 // Current printing format makes assumptions about connectors
 // which will be invalid, in general. XXX FIMXE, someday.
+//
+// These are called in the inner loops, and so bail out early, unless
+// fine logging is enabled; otherwise, strings would be built up for
+// every step, only to be thrown away by the logger.
 
 void Frame::print_section(const Handle& section)
 {
+	if (not logger().is_fine_enabled()) return;
 	logger().fine("    %s:",
 		section->getOutgoingAtom(0)->get_name().c_str());
 	const HandleSeq& conseq = section->getOutgoingAtom(1)->getOutgoingSet();
@@ -72,6 +121,7 @@ void Frame::print_section(const Handle& section)
 
 void Frame::print(void) const
 {
+	if (not logger().is_fine_enabled()) return;
 	logger().fine("Frame:");
 	std::string pts;
 	for (const Handle& pt : _open_points)
@@ -91,10 +141,9 @@ void Frame::print(void) const
 
 void Odometer::print_wheel(const Frame& frm, size_t i) const
 {
-	bool sect_open = true;
-	const Handle& fm_sect = _sections[i];
-	if (frm._open_sections.find(fm_sect) == frm._open_sections.end())
-		sect_open = false;
+	if (not logger().is_fine_enabled()) return;
+	const Handle& fm_sect = section(i);
+	bool sect_open = frm._open_sections.contains(fm_sect);
 
 	const Handle& disj = fm_sect->getOutgoingAtom(1);
 	const Handle& fm_con = disj->getOutgoingAtom(_from_index[i]);
@@ -103,7 +152,7 @@ void Odometer::print_wheel(const Frame& frm, size_t i) const
 	if (conn_open)
 		logger().fine("    wheel %lu: %s : %s\t: %s -> %s (sect %s; conn %s)",
 			i,
-			_sections[i]->getOutgoingAtom(0)->get_name().c_str(),
+			fm_sect->getOutgoingAtom(0)->get_name().c_str(),
 			fm_con->getOutgoingAtom(0)->get_name().c_str(),
 			fm_con->getOutgoingAtom(1)->get_name().c_str(),
 			_to_connectors[i]->getOutgoingAtom(1)->get_name().c_str(),
@@ -115,7 +164,7 @@ void Odometer::print_wheel(const Frame& frm, size_t i) const
 		const Handle& lnkset = fm_con->getOutgoingAtom(1);
 		logger().fine("    wheel %lu: %s : %s\t: %s -> %s (sect %s; conn %s)",
 			i,
-			_sections[i]->getOutgoingAtom(0)->get_name().c_str(),
+			fm_sect->getOutgoingAtom(0)->get_name().c_str(),
 			fm_con->getOutgoingAtom(0)->get_name().c_str(),
 			lnkset->getOutgoingAtom(0)->get_name().c_str(),
 			lnkset->getOutgoingAtom(1)->get_name().c_str(),
@@ -127,6 +176,7 @@ void Odometer::print_wheel(const Frame& frm, size_t i) const
 
 void Odometer::print_odometer(const Frame& frm) const
 {
+	if (not logger().is_fine_enabled()) return;
 	logger().fine("Odometer State: length %lu", _size);
 	for (size_t i=0; i<_size; i++)
 		print_wheel(frm, i);
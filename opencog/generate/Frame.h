@@ -22,7 +22,11 @@
 #ifndef _OPENCOG_FRAME_H
 #define _OPENCOG_FRAME_H
 
+#include <unordered_map>
+
 #include <opencog/atomspace/AtomSpace.h>
+#include <opencog/generate/Embedding.h>
+#include <opencog/generate/PersistentMap.h>
 
 namespace opencog
 {
@@ -30,17 +34,55 @@ namespace opencog
  *  @{
  */
 
-/// Current traversal state
+typedef PersistentSet<Handle> PersistentHandleSet;
+typedef PersistentMap<Handle, size_t> PersistentHandleCounter;
+
+/// Current traversal state.
+///
+/// The sets in the frame share structure with those of the frames
+/// that it was copied from, so that pushing a frame, or taking a
+/// snapshot of it (e.g. to hand the search below it to another thread)
+/// costs a few pointer copies, no matter how large the assembly is.
 struct Frame
 {
 	/// Points that are unconnected
-	HandleSet _open_points;
+	PersistentHandleSet _open_points;
 
 	/// Sections with unconnected connectors.
-	HandleSet _open_sections;
+	PersistentHandleSet _open_sections;
 
 	/// Completed links.
-	HandleSet _linkage;
+	PersistentHandleSet _linkage;
+
+	/// Hash of the frame, up to the unique point names. This is the
+	/// sum of `Shape::section_key()` over all open and linked
+	/// sections, plus `Shape::link_key()` over all links. It is a
+	/// sum, rather than a Zobrist XOR, so that identical pieces do
+	/// not cancel. It is updated with each connection.
+	size_t _hash;
+
+	/// Number of unconnected connectors of each kind (link type and
+	/// pole), over all of the open sections.
+	PersistentHandleCounter _open_cons;
+	size_t _open_count;
+	void open_connector(const Handle&);
+	void close_connector(const Handle&);
+
+	/// Number of links of each type, for the link types that are
+	/// limited by the callback. Popping the frame undoes the counts.
+	PersistentHandleCounter _link_counts;
+
+	/// Distance of each point from the nuclei, counted in pieces.
+	/// Used by the depth-first search only; the nuclei are not listed.
+	PersistentHandleCounter _distance;
+
+	/// Distance from the nuclei of the piece connected last, in the
+	/// depth-first search; this is what `max_depth` limits there.
+	/// Zero for the odometer, which uses `_nodo` instead.
+	size_t _reach;
+
+	/// Drawing of the assembly, if planarity is being enforced.
+	Embedding _embedding;
 
 	/// The depth of the odometer stack, and the odometer wheel
 	/// that this frame is isolating. State earlier than this is
@@ -49,6 +91,7 @@ struct Frame
 	size_t _wheel;
 
 	void clear(void);
+	void merge(const Frame&);
 	void print(void) const;
 
 	static void print_section(const Handle&);
@@ -60,11 +103,22 @@ struct Odometer
 	/// Size of odometer. All vectors below are of this size.
 	size_t _size;
 
-	/// Ordered list of from-sections which have unconnected connectors
-	// that are being explored as a part of this odometer.
-	/// from-connectors.
+	/// List of from-sections which have unconnected connectors
+	/// that are being explored as a part of this odometer. Each
+	/// section appears once; the wheels refer to them by index, so
+	/// that connecting a section updates just one slot.
 	HandleSeq _sections;
 
+	/// The slot in `_sections` holding the section of each wheel.
+	std::vector<size_t> _slot;
+
+	/// Map from sections back to their slot.
+	std::unordered_map<Handle, size_t> _slot_of;
+
+	const Handle& section(size_t wheel) const {
+		return _sections[_slot[wheel]];
+	}
+
 	/// Index into the corresponding section, pointing at the open
 	/// connector (the "from-connector").
 	std::vector<size_t> _from_index;
@@ -22,8 +22,13 @@
 #ifndef _OPENCOG_GENERATE_CALLBACK_H
 #define _OPENCOG_GENERATE_CALLBACK_H
 
+#include <functional>
+#include <map>
+#include <set>
+
 #include <opencog/atomspace/AtomSpace.h>
 #include <opencog/generate/Frame.h>
+#include <opencog/generate/SolutionCollector.h>
 
 namespace opencog
 {
@@ -31,6 +36,8 @@ namespace opencog
  *  @{
  */
 
+typedef std::function<void(const HandleSet&)> SolutionVisitor;
+
 /// Aggregation selection callbacks. As an assembly is being created,
 /// that assembly will have unconnected, open connectors on it.
 /// Aggregation proceeds by attaching sections ("puzzle pieces") to
@@ -45,7 +52,9 @@ namespace opencog
 /// depends on the history of what was previously attached. Because
 /// the algo is breadt-first (see other descriptions) two stacks are
 /// maintained: one for each "row" (odometer) and one for each
-/// odometer-wheel.
+/// odometer-wheel. The depth-first algo (see `strategy` below) pushes
+/// a frame for each connection, and an odometer for each connector
+/// that it extends.
 ///
 class GenerateCallback
 {
@@ -76,7 +85,7 @@ public:
 	/// Given a connector, return a set of matching connectors
 	/// that this particular connector could connect to. This
 	/// set may be empty, or may contain more than one match.
-	virtual HandleSeq joints(const Handle&) = 0;
+	virtual const HandleSeq& joints(const Handle&) = 0;
 
 	/// Given an existing connected section `fm_sect` and a connector
 	/// `fm_con` on that section, as well as a mating `to_con`, return
@@ -95,6 +104,22 @@ public:
 	                      const Handle& fm_sect, size_t offset,
 	                      const Handle& to_con) = 0;
 
+	/// Return a lower bound on the number of sections that must still
+	/// be added to the frame, in order to close all of its unconnected
+	/// connectors, or SIZE_MAX if they can never all be closed. Frames
+	/// that cannot be completed within `max_network_size` are cut as
+	/// soon as they are created. The default makes no claim.
+	virtual size_t min_to_close(const Frame&) { return 0; }
+
+	/// Called when a section is added to the set of open sections of
+	/// the current frame, and when it is removed from it (because it
+	/// was connected, and so replaced by a newly-connected section).
+	/// Callbacks that keep their own indexes of the open sections can
+	/// use these to keep them up to date; changes made after a
+	/// `push_frame()` should be undone by the matching `pop_frame()`.
+	virtual void open_section(const Handle& sect) {}
+	virtual void close_section(const Handle& sect) {}
+
 	/// Create a link from connector `fm_con` to connector `to_con`,
 	/// which will connect `fm_pnt` to `to_pnt`.
 	virtual Handle make_link(const Handle& fm_con, const Handle& to_con,
@@ -131,6 +156,12 @@ public:
 	/// maintanence pertaining to reporting the solutions.
 	virtual Handle get_solutions(void) = 0;
 
+	/// Call `visit` on each of the solutions that were reported via
+	/// the above callback, without copying them, and without creating
+	/// any Atoms. Callbacks that do not keep their solutions need not
+	/// provide this.
+	virtual void visit_solutions(const SolutionVisitor&) {}
+
 	// ---------------------------------------------------------------
 	/// Generic Parameters
 	/// These are parameters that all callback systems might reasonably
@@ -141,6 +172,69 @@ public:
 	/// this number is reached.
 	size_t max_solutions = -1;
 
+	/// If not null, solutions are also recorded in this collector,
+	/// which may be shared with callbacks running on other threads.
+	/// The solution count, and thus `max_solutions`, is then global,
+	/// across all of the threads sharing the collector.
+	SolutionCollector* collector = nullptr;
+
+	/// If set, each new solution is handed over to this as soon as it
+	/// is found (on the thread doing the aggregation), instead of being
+	/// kept until `get_solutions()` is called. This may block, e.g. to
+	/// hold up the search until the solution can be dealt with.
+	std::function<void(HandleSet&&)> stream;
+
+	/// How the aggregator searches.
+	/// BREADTH_FIRST: attach a piece to every open connector at once,
+	///     using an odometer, before going deeper. This finds the
+	///     small networks first.
+	/// DEPTH_FIRST: attach a piece to one open connector, and recurse.
+	///     This needs memory in proportion to the depth only, and
+	///     is cheaper for grammars with few choices per connector.
+	/// ITERATIVE_DEEPENING: repeat the depth-first search, allowing
+	///     one more section each time, up to `max_network_size`.
+	///     This finds the smallest networks first, as breadth-first
+	///     does, with the memory use of depth-first.
+	/// MEET_IN_THE_MIDDLE: grow each nucleus on its own, out to
+	///     `meet_radius`, then join the partial assemblies and finish
+	///     them depth-first. For several nuclei that lie far apart.
+	enum Strategy
+	{
+		BREADTH_FIRST,
+		DEPTH_FIRST,
+		ITERATIVE_DEEPENING,
+		MEET_IN_THE_MIDDLE
+	};
+	Strategy strategy = BREADTH_FIRST;
+
+	/// The distance, in pieces, that each nucleus is grown out to
+	/// before the meet-in-the-middle strategy joins them up.
+	size_t meet_radius = 2;
+
+	/// Record only one solution of each shape: solutions that are
+	/// isomorphic to an earlier solution are counted, but not kept.
+	/// Points are compared by their base names, links by their type.
+	bool dedupe_isomorphic = false;
+
+	/// Number of fully-explored frames to remember. A frame that is
+	/// the same (up to the unique point names) as one that was already
+	/// fully explored is not explored again. Zero disables this.
+	size_t max_transpositions = 0;
+
+	/// Refuse links that cannot be drawn without crossing the links
+	/// already made, taking the connectors of each section to be in
+	/// clockwise order around the point. The order is fixed; networks
+	/// that are planar only for some other order are refused, too.
+	/// See `Embedding.h`.
+	bool planar = false;
+
+	/// As above, and also keep the bottoms of all of the points on
+	/// one face, so that they can be lined up, with the links drawn
+	/// above them. Implies `planar`. Unlike the Link Grammar rule,
+	/// the order of the points along the line, and so the direction
+	/// of each link, is not checked.
+	bool projective = false;
+
 	/// Allow connectors on an open section to connect back onto
 	/// themselves (if the other mating rules allow the two connectors
 	/// to connect).
@@ -157,14 +251,28 @@ public:
 	/// This is ignored if `pair_any_links` (above) is 1.
 	size_t pair_typed_links = 1;
 
+	/// Maximum number of links of each given type (e.g. at most one
+	/// subject link in a sentence). Link types not listed here may
+	/// appear any number of times.
+	std::map<Handle, size_t> link_limits;
+
+	/// Pairs of connectors that must close cycles: when some open
+	/// section could take the link, it must go there, and not to a
+	/// fresh piece. For example, in a wall-noun-verb triangle, the
+	/// wall-verb link must close the triangle, and not start on a
+	/// second wall. The pairs are unordered.
+	std::set<HandlePair> must_close;
+
 	/// Maximum size of the generated network. Exploration of networks
 	/// larger than this will not be attempted.
 	size_t max_network_size = -1;
 
-	/// Maximum depth to explore from the starting point. This is
-	/// counted in terms of the maximum depth of the stack of
-	/// odometers. This is maximum diameter of the network, as measured
-	/// from the starting point.
+	/// Maximum depth to explore from the starting point. For the
+	/// odometer, this is counted in terms of the maximum depth of the
+	/// stack of odometers (`Frame::_nodo`); for the depth-first search,
+	/// it is the distance of the newest piece from the nuclei
+	/// (`Frame::_reach`). This is maximum diameter of the network, as
+	/// measured from the starting point.
 	size_t max_depth = -1;
 
 	/// Maximum number of odometer steps to take. This needs to be
@@ -0,0 +1,464 @@
+/*
+ * opencog/generate/Growth.cc
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <queue>
+#include <uuid/uuid.h>
+
+#include <opencog/util/Logger.h>
+#include <opencog/atoms/base/Link.h>
+#include <opencog/atoms/base/Node.h>
+
+#include "Growth.h"
+
+using namespace opencog;
+
+Growth::Growth(AtomSpace* as, const Dictionary& dict)
+	: _as(as), _dict(dict)
+{
+	std::random_device seed;
+	_rangen.seed(seed());
+
+	uuid_t uu;
+	uuid_generate(uu);
+	char uustr[37];
+	uuid_unparse(uu, uustr);
+	_id_prefix = uustr;
+
+	_cancel = false;
+}
+
+Growth::~Growth() {}
+
+void Growth::seed(unsigned long sd)
+{
+	_rangen.seed(sd);
+	_id_prefix = std::to_string(sd);
+}
+
+/// Return true if connector `fm_con` can attach to `to_con`.
+bool Growth::mates(const Handle& fm_con, const Handle& to_con) const
+{
+	for (const Handle& mate : _dict.joints(fm_con))
+		if (*mate == *to_con) return true;
+	return false;
+}
+
+Handle Growth::connector(const End& end) const
+{
+	return _sections[end.point]->getOutgoingAtom(1)->getOutgoingAtom(end.slot);
+}
+
+size_t Growth::add_point(const Handle& sect)
+{
+	_sections.push_back(sect);
+	_mates.emplace_back(sect->getOutgoingAtom(1)->get_arity(),
+		End{SIZE_MAX, SIZE_MAX});
+	return _sections.size() - 1;
+}
+
+void Growth::join(const End& fm, const End& to)
+{
+	_mates[fm.point][fm.slot] = to;
+	_mates[to.point][to.slot] = fm;
+}
+
+/// Return the leaves that can close `con`.
+const HandleSeq& Growth::leaves(const Handle& con)
+{
+	auto lit = _leaves.find(con);
+	if (_leaves.end() != lit) return lit->second;
+
+	HandleSeq& lvs = _leaves[con];
+	for (const Handle& mate : _dict.joints(con))
+		for (const Handle& sect : _dict.connectables(mate))
+			if (1 == sect->getOutgoingAtom(1)->get_arity())
+				lvs.push_back(sect);
+	return lvs;
+}
+
+/// Return the pieces that can be inserted into an edge running from
+/// `fm_con` to `to_con`. These are worked out the first time that
+/// they are asked for.
+const std::vector<Growth::Rule>& Growth::rules(const Handle& fm_con,
+                                               const Handle& to_con)
+{
+	HandlePair key(fm_con, to_con);
+	auto rit = _rules.find(key);
+	if (_rules.end() != rit) return rit->second;
+
+	std::vector<Rule>& rls = _rules[key];
+	for (const Handle& fm_mate : _dict.joints(fm_con))
+	{
+		for (const Handle& sect : _dict.connectables(fm_mate))
+		{
+			const HandleSeq& seq = sect->getOutgoingAtom(1)->getOutgoingSet();
+			for (size_t i = 0; i < seq.size(); i++)
+			{
+				if (*seq[i] != *fm_mate) continue;
+				for (size_t j = 0; j < seq.size(); j++)
+				{
+					if (i == j or not mates(to_con, seq[j])) continue;
+
+					// Every other connector must take a leaf.
+					bool closable = true;
+					for (size_t k = 0; k < seq.size() and closable; k++)
+						if (k != i and k != j and leaves(seq[k]).empty())
+							closable = false;
+					if (closable) rls.push_back({sect, i, j});
+				}
+			}
+		}
+	}
+	logger().fine("Growth: %lu pieces fit between %s and %s", rls.size(),
+		fm_con->to_short_string().c_str(), to_con->to_short_string().c_str());
+	return rls;
+}
+
+/// Pair up the ends of `bond`, taking `p_sect` to be the lexis section
+/// of its point `p`, and `q_sect` that of `q`. Each end on `p` is paired
+/// with an end on `q` whose connector it mates; for a link from a point
+/// back to itself, the ends are paired among themselves. The pairs are
+/// appended to `pairs`, if it is given. Returns false if some end is
+/// left over.
+bool Growth::pair_up(const Bond& bond,
+                     const Handle& p_sect, const Handle& q_sect,
+                     std::vector<std::pair<End, End>>* pairs) const
+{
+	const HandleSeq& pcons = p_sect->getOutgoingAtom(1)->getOutgoingSet();
+	const HandleSeq& qcons = q_sect->getOutgoingAtom(1)->getOutgoingSet();
+	const std::vector<size_t>& ps = bond.p_slots;
+	const std::vector<size_t>& qs = bond.q_slots;
+
+	if (bond.p == bond.q)
+	{
+		std::vector<bool> used(ps.size(), false);
+		for (size_t i = 0; i < ps.size(); i++)
+		{
+			if (used[i]) continue;
+			size_t j = i + 1;
+			while (j < ps.size() and
+			       (used[j] or not mates(pcons[ps[i]], pcons[ps[j]])))
+				j++;
+			if (j == ps.size()) return false;
+			used[j] = true;
+			if (pairs) pairs->push_back({{bond.p, ps[i]}, {bond.p, ps[j]}});
+		}
+		return true;
+	}
+
+	if (ps.size() != qs.size()) return false;
+	std::vector<bool> used(qs.size(), false);
+	for (size_t i = 0; i < ps.size(); i++)
+	{
+		size_t j = 0;
+		while (j < qs.size() and
+		       (used[j] or not mates(pcons[ps[i]], qcons[qs[j]])))
+			j++;
+		if (j == qs.size()) return false;
+		used[j] = true;
+		if (pairs) pairs->push_back({{bond.p, ps[i]}, {bond.q, qs[j]}});
+	}
+	return true;
+}
+
+/// Take apart the seed network. The links of the seed do not say which
+/// way they point, and so the lexis section of each point is worked out
+/// from the name of the point, the types of its links, and the sections
+/// of its neighbors: at each link, the connectors on the two ends must
+/// mate. The ends of each link are paired up across the two points that
+/// it joins, and not in the order that they were found, so that parallel
+/// links, and links that close a cycle, come apart correctly.
+void Growth::decode(const Handle& seed)
+{
+	const HandleSeq& sects = seed->getOutgoingSet();
+	size_t npts = sects.size();
+
+	// The lexis sections that each point might have been made from:
+	// those having the right link types in the right places.
+	std::vector<HandleSeq> cands(npts);
+	std::vector<Bond> bonds;
+	std::map<Handle, size_t> bond_index;
+	for (size_t pt = 0; pt < npts; pt++)
+	{
+		const Handle& sect = sects[pt];
+		const Handle& upoint = sect->getOutgoingAtom(0);
+		const HandleSeq& seq = sect->getOutgoingAtom(1)->getOutgoingSet();
+		const std::string& name = upoint->get_name();
+		Handle point(_as->get_node(upoint->get_type(),
+			name.substr(0, name.rfind('@'))));
+
+		for (const Handle& entry : _dict.entries(point))
+		{
+			const HandleSeq& cons = entry->getOutgoingAtom(1)->getOutgoingSet();
+			if (cons.size() != seq.size()) continue;
+
+			bool match = true;
+			for (size_t i = 0; i < seq.size() and match; i++)
+				if (CONNECTOR == seq[i]->get_type() or
+				    *cons[i]->getOutgoingAtom(0) != *seq[i]->getOutgoingAtom(0))
+					match = false;
+			if (match) cands[pt].push_back(entry);
+		}
+		if (cands[pt].empty())
+			throw RuntimeException(TRACE_INFO,
+				"Not a complete section from the lexis: %s",
+				sect->to_short_string().c_str());
+
+		// A link is seen first at `p`; the next point that holds it
+		// is `q`. No third point may hold it.
+		for (size_t i = 0; i < seq.size(); i++)
+		{
+			auto bit = bond_index.find(seq[i]);
+			if (bond_index.end() == bit)
+			{
+				bit = bond_index.emplace(seq[i], bonds.size()).first;
+				bonds.push_back({seq[i], pt, pt});
+			}
+			Bond& bond = bonds[bit->second];
+			if (pt == bond.p)
+				bond.p_slots.push_back(i);
+			else if (pt == bond.q or bond.p == bond.q)
+			{
+				bond.q = pt;
+				bond.q_slots.push_back(i);
+			}
+			else
+				throw RuntimeException(TRACE_INFO,
+					"The seed network is broken at %s",
+					seq[i]->to_short_string().c_str());
+		}
+	}
+
+	// Drop the candidates that cannot be paired up with any candidate
+	// at the other end of one of their links. Repeat, until nothing
+	// more is dropped.
+	bool changed = true;
+	while (changed)
+	{
+		changed = false;
+		for (const Bond& bond : bonds)
+		{
+			HandleSeq& pc = cands[bond.p];
+			HandleSeq& qc = cands[bond.q];
+			size_t np = pc.size();
+			size_t nq = qc.size();
+			if (bond.p == bond.q)
+			{
+				pc.erase(std::remove_if(pc.begin(), pc.end(),
+					[&](const Handle& ps) {
+						return not pair_up(bond, ps, ps, nullptr);
+					}), pc.end());
+			}
+			else
+			{
+				pc.erase(std::remove_if(pc.begin(), pc.end(),
+					[&](const Handle& ps) {
+						for (const Handle& qs : qc)
+							if (pair_up(bond, ps, qs, nullptr)) return false;
+						return true;
+					}), pc.end());
+				qc.erase(std::remove_if(qc.begin(), qc.end(),
+					[&](const Handle& qs) {
+						for (const Handle& ps : pc)
+							if (pair_up(bond, ps, qs, nullptr)) return false;
+						return true;
+					}), qc.end());
+			}
+
+			if (pc.empty() or qc.empty())
+				throw RuntimeException(TRACE_INFO,
+					"The seed network is broken at %s",
+					bond.link->to_short_string().c_str());
+			if (np != pc.size() or nq != qc.size()) changed = true;
+		}
+	}
+
+	// Give each point the first candidate that fits with the points
+	// chosen before it, visiting the points breadth-first, so that on
+	// a tree, just one neighbor has been chosen, and the pruning above
+	// ensures that some candidate fits. Around a cycle, none might.
+	std::vector<std::vector<size_t>> bonds_at(npts);
+	for (size_t b = 0; b < bonds.size(); b++)
+	{
+		bonds_at[bonds[b].p].push_back(b);
+		if (bonds[b].q != bonds[b].p) bonds_at[bonds[b].q].push_back(b);
+	}
+	HandleSeq chosen(npts);
+	std::vector<bool> queued(npts, false);
+	for (size_t start = 0; start < npts; start++)
+	{
+		if (queued[start]) continue;
+		queued[start] = true;
+		std::queue<size_t> todo;
+		todo.push(start);
+		while (not todo.empty())
+		{
+			size_t pt = todo.front();
+			todo.pop();
+			for (const Handle& cand : cands[pt])
+			{
+				bool fit = true;
+				for (size_t b : bonds_at[pt])
+				{
+					const Bond& bond = bonds[b];
+					size_t other = (pt == bond.p) ? bond.q : bond.p;
+					if (other != pt and nullptr == chosen[other]) continue;
+
+					const Handle& ps = (pt == bond.p) ? cand : chosen[bond.p];
+					const Handle& qs = (pt == bond.q) ? cand : chosen[bond.q];
+					if (not pair_up(bond, ps, qs, nullptr)) { fit = false; break; }
+				}
+				if (fit) { chosen[pt] = cand; break; }
+			}
+			if (nullptr == chosen[pt])
+				throw RuntimeException(TRACE_INFO,
+					"The seed network does not fit the lexis at %s",
+					sects[pt]->to_short_string().c_str());
+
+			for (size_t b : bonds_at[pt])
+			{
+				size_t other = (pt == bonds[b].p) ? bonds[b].q : bonds[b].p;
+				if (queued[other]) continue;
+				queued[other] = true;
+				todo.push(other);
+			}
+		}
+	}
+	for (const Handle& lex : chosen) add_point(lex);
+
+	// Join the ends, in the order that the links were found, so that
+	// seeded runs repeat.
+	for (const Bond& bond : bonds)
+	{
+		std::vector<std::pair<End, End>> pairs;
+		pair_up(bond, _sections[bond.p], _sections[bond.q], &pairs);
+		for (const auto& pr : pairs)
+		{
+			join(pr.first, pr.second);
+			_edges.push_back(pr.first);
+		}
+	}
+}
+
+/// Break the edge `_edges[ie]`, and insert a piece into it. If no piece
+/// fits, the edge is dropped from the list, and false is returned.
+bool Growth::insert(size_t ie)
+{
+	End fm(_edges[ie]);
+	End to(_mates[fm.point][fm.slot]);
+
+	const std::vector<Rule>& rls = rules(connector(fm), connector(to));
+	if (rls.empty())
+	{
+		_edges[ie] = _edges.back();
+		_edges.pop_back();
+		return false;
+	}
+
+	std::uniform_int_distribution<size_t> pick(0, rls.size() - 1);
+	const Rule& rule = rls[pick(_rangen)];
+
+	// The edge at `ie` now ends on the new piece; the new piece gets
+	// an edge to the old far end, and one for each leaf.
+	size_t pt = add_point(rule.sect);
+	join(fm, {pt, rule.fm_slot});
+	join({pt, rule.to_slot}, to);
+	_edges.push_back({pt, rule.to_slot});
+
+	const HandleSeq& seq = rule.sect->getOutgoingAtom(1)->getOutgoingSet();
+	for (size_t i = 0; i < seq.size(); i++)
+	{
+		if (i == rule.fm_slot or i == rule.to_slot) continue;
+
+		const HandleSeq& lvs = leaves(seq[i]);
+		std::uniform_int_distribution<size_t> pick_leaf(0, lvs.size() - 1);
+		size_t leaf = add_point(lvs[pick_leaf(_rangen)]);
+		join({pt, i}, {leaf, 0});
+		_edges.push_back({pt, i});
+	}
+	return true;
+}
+
+/// Write out the network, in the form that aggregation produces: a
+/// SetLink of sections, with each connector replaced by its link.
+Handle Growth::network(void)
+{
+	size_t npts = _sections.size();
+	HandleSeq points;
+	points.reserve(npts);
+	for (size_t i = 0; i < npts; i++)
+	{
+		const Handle& point = _sections[i]->getOutgoingAtom(0);
+		points.push_back(createNode(point->get_type(),
+			point->get_name() + "@" + _id_prefix + "-" + std::to_string(i)));
+	}
+
+	// Make each link once, from the first of its two ends.
+	std::vector<HandleSeq> seqs(npts);
+	for (size_t i = 0; i < npts; i++)
+		seqs[i].resize(_mates[i].size());
+	for (size_t i = 0; i < npts; i++)
+	{
+		for (size_t s = 0; s < _mates[i].size(); s++)
+		{
+			const End& to = _mates[i][s];
+			if (to.point < i or (to.point == i and to.slot < s)) continue;
+
+			Handle linkty(connector({i, s})->getOutgoingAtom(0));
+			Handle lnk(createLink(EVALUATION_LINK, linkty,
+				createLink(SET_LINK, points[i], points[to.point])));
+			seqs[i][s] = lnk;
+			seqs[to.point][to.slot] = lnk;
+		}
+	}
+
+	HandleSeq sects;
+	sects.reserve(npts);
+	for (size_t i = 0; i < npts; i++)
+		sects.push_back(createLink(SECTION, points[i],
+			createLink(std::move(seqs[i]), CONNECTOR_SEQ)));
+	return createLink(std::move(sects), SET_LINK);
+}
+
+Handle Growth::grow(const Handle& seed)
+{
+	_cancel = false;
+	_sections.clear();
+	_mates.clear();
+	_edges.clear();
+	decode(seed);
+
+	size_t steps = 0;
+	while (_sections.size() < max_network_size and steps < max_steps and
+	       not _edges.empty() and not _cancel)
+	{
+		std::uniform_int_distribution<size_t> pick(0, _edges.size() - 1);
+		insert(pick(_rangen));
+		steps++;
+	}
+
+	logger().fine("Growth: %lu points after %lu steps, %lu edges left",
+		_sections.size(), steps, _edges.size());
+	return network();
+}
+
+// ========================== END OF FILE ==========================
@@ -0,0 +1,154 @@
+/*
+ * opencog/generate/Growth.h
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_GROWTH_H
+#define _OPENCOG_GROWTH_H
+
+#include <atomic>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/generate/Dictionary.h>
+
+namespace opencog
+{
+/** \addtogroup grp_generate
+ *  @{
+ */
+
+/// Grow a network by insertion, in the style of the Lindenmayer
+/// systems of Prusinkiewicz, instead of assembling it piece by piece.
+///
+/// Growth starts from a complete network (with no unconnected
+/// connectors), such as one found by aggregation. At each step, an
+/// edge is picked at random, broken, and a piece from the lexis is
+/// inserted in its place: a piece with one connector that mates the
+/// connector at one end of the edge, and another that mates the one
+/// at the other end. Any other connectors on the inserted piece are
+/// closed with leaves, that is, with pieces from the lexis that have
+/// just one connector. Thus, the network is complete after every step;
+/// there is no backtracking, and each step costs the same, no matter
+/// how large the network has grown. Edges that no piece can be
+/// inserted into are set aside, and never picked again.
+///
+/// The network is kept in plain arrays, and not in the AtomSpace,
+/// until it is asked for.
+class Growth
+{
+	AtomSpace* _as;
+	Dictionary _dict;
+
+	/// Connector `slot` of `point`.
+	struct End
+	{
+		size_t point;
+		size_t slot;
+	};
+
+	/// The lexis section of each point, and, for each connector on
+	/// it, the connector at the other end of its link.
+	HandleSeq _sections;
+	std::vector<std::vector<End>> _mates;
+
+	/// One end of each edge that might still be broken.
+	std::vector<End> _edges;
+
+	/// A piece that can be inserted into an edge: connector `fm_slot`
+	/// takes the first end of the edge, and `to_slot` the second.
+	struct Rule
+	{
+		Handle sect;
+		size_t fm_slot;
+		size_t to_slot;
+	};
+	std::map<HandlePair, std::vector<Rule>> _rules;
+	const std::vector<Rule>& rules(const Handle&, const Handle&);
+
+	/// Pieces with a single connector, that can close a given connector.
+	std::map<Handle, HandleSeq> _leaves;
+	const HandleSeq& leaves(const Handle&);
+
+	/// A link of the seed network, running between points `p` and `q`,
+	/// and the connector slots that hold it on each. There may be more
+	/// than one slot on each, if there are parallel links of the same
+	/// type. For a link from a point back to itself, `p == q`, and all
+	/// of the slots are in `p_slots`.
+	struct Bond
+	{
+		Handle link;
+		size_t p;
+		size_t q;
+		std::vector<size_t> p_slots;
+		std::vector<size_t> q_slots;
+	};
+	bool pair_up(const Bond&, const Handle&, const Handle&,
+	             std::vector<std::pair<End, End>>*) const;
+
+	bool mates(const Handle&, const Handle&) const;
+	Handle connector(const End&) const;
+	size_t add_point(const Handle&);
+	void join(const End&, const End&);
+	void decode(const Handle&);
+	bool insert(size_t);
+	Handle network(void);
+
+	std::mt19937 _rangen;
+	std::string _id_prefix;
+	std::atomic<bool> _cancel;
+
+public:
+	Growth(AtomSpace*, const Dictionary&);
+	~Growth();
+
+	/// Stop growing when the network has this many points.
+	size_t max_network_size = 1000;
+
+	/// Maximum number of insertions to try.
+	size_t max_steps = SIZE_MAX;
+
+	/// Make the growth repeatable. The unique point names are made
+	/// from the seed, instead of a UUID.
+	void seed(unsigned long);
+
+	/// Grow the network `seed`, a link holding the sections of a
+	/// complete network, as returned by aggregation. Returns the grown
+	/// network, in the same form: a SetLink of sections. Each point of
+	/// the seed must be named as by `LinkStyle`, that is, with the name
+	/// of the lexis point, followed by an `@` and a unique suffix, and
+	/// each link must have its link type as its first atom.
+	Handle grow(const Handle& seed);
+
+	/// The number of points in the network, as grown so far.
+	size_t size(void) const { return _sections.size(); }
+
+	/// Stop the growth under way. The cancel is forgotten when the
+	/// next growth is started.
+	void cancel(void) { _cancel = true; }
+};
+
+
+/** @}*/
+}  // namespace opencog
+
+#endif // _OPENCOG_GROWTH_H
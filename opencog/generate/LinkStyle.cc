@@ -29,7 +29,7 @@
 
 using namespace opencog;
 
-LinkStyle::LinkStyle(void) : _scratch(nullptr)
+LinkStyle::LinkStyle(void) : _scratch(nullptr), _id_count(0)
 {
 }
 
@@ -42,10 +42,17 @@ LinkStyle::LinkStyle(void) : _scratch(nullptr)
 /// generate a unique string for that node.
 Handle LinkStyle::create_unique_section(const Handle& sect)
 {
-	uuid_t uu;
-	uuid_generate(uu);
-	char idstr[37];
-	uuid_unparse(uu, idstr);
+	std::string idstr;
+	if (_id_prefix.empty())
+	{
+		uuid_t uu;
+		uuid_generate(uu);
+		char uustr[37];
+		uuid_unparse(uu, uustr);
+		idstr = uustr;
+	}
+	else
+		idstr = _id_prefix + "-" + std::to_string(_id_count++);
 
 	Handle point = sect->getOutgoingAtom(0);
 	Handle disj = sect->getOutgoingAtom(1);
@@ -68,10 +75,21 @@ Handle LinkStyle::create_unique_section(const Handle& sect)
 
 	// Record it's original type.
 	// _inhsects.emplace_back(createLink(INHERITANCE_LINK, upoint, sect));
+	_origin[upoint] = sect;
 
 	return usect;
 }
 
+/// Return the lexis section that the unique section `usect` was
+/// created from, or the undefined handle, if it was not created by
+/// `create_unique_section()`.
+Handle LinkStyle::lexis_origin(const Handle& usect) const
+{
+	auto orit = _origin.find(usect->getOutgoingAtom(0));
+	if (_origin.end() == orit) return Handle::UNDEFINED;
+	return orit->second;
+}
+
 /// Create an undirected edge connecting the two points `fm_pnt` and
 /// `to_pnt`, using the connectors `fm_con` and `to_con`. The edge
 /// is "undirected" because a SetLink is used to hold the two
@@ -160,6 +178,9 @@ void LinkStyle::clear(void)
 {
 	_mempoints.clear();
 	_inhsects.clear();
+	_origin.clear();
+	_id_prefix.clear();
+	_id_count = 0;
 }
 
 void LinkStyle::save_work(AtomSpace* as)
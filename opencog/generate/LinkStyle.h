@@ -22,6 +22,8 @@
 #ifndef _OPENCOG_LINK_STYLE_H
 #define _OPENCOG_LINK_STYLE_H
 
+#include <unordered_map>
+
 #include <opencog/atomspace/AtomSpace.h>
 
 namespace opencog
@@ -42,11 +44,21 @@ protected:
 	HandleSeq _mempoints;
 	HandleSeq _inhsects;
 
+	/// Map from unique points to the lexis section they came from.
+	std::unordered_map<Handle, Handle> _origin;
+
+	/// If not empty, unique points are named with this prefix and a
+	/// serial number, instead of a UUID, so that repeated runs give
+	/// the same names.
+	std::string _id_prefix;
+	size_t _id_count;
+
 public:
 	LinkStyle(void);
 	void clear(void);
 
 	Handle create_unique_section(const Handle&);
+	Handle lexis_origin(const Handle&) const;
 	Handle create_undirected_link(const Handle&, const Handle&,
 	                              const Handle&, const Handle&);
 
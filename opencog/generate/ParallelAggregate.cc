@@ -0,0 +1,120 @@
+/*
+ * opencog/generate/ParallelAggregate.cc
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+#include <opencog/util/Logger.h>
+
+#include "Aggregate.h"
+#include "ParallelAggregate.h"
+
+using namespace opencog;
+
+ParallelAggregate::ParallelAggregate(AtomSpace* as) : _as(as)
+{
+}
+
+ParallelAggregate::~ParallelAggregate() {}
+
+/// Make attempts `0` through `num_attempts-1`, on `num_threads`
+/// threads (zero means one per core), and return the solutions, in
+/// attempt order, up to `max_solutions` of them.
+HandleSeq ParallelAggregate::aggregate(const HandleSet& nuclei,
+                                       const RandomCallback& proto,
+                                       unsigned long seed,
+                                       size_t num_attempts,
+                                       size_t num_threads)
+{
+	if (0 == num_threads) num_threads = std::thread::hardware_concurrency();
+	if (0 == num_threads) num_threads = 1;
+
+	// Solutions of attempts that finished before some earlier attempt.
+	std::vector<HandleSeq> pending(num_attempts);
+	std::vector<bool> done(num_attempts, false);
+	size_t reduced = 0;
+	HandleSeq solns;
+
+	std::mutex mtx;
+	std::atomic<size_t> next_attempt(0);
+	std::atomic<bool> enough(false);
+	std::exception_ptr failure;
+
+	auto work = [&](void)
+	{
+		while (not enough)
+		{
+			size_t attempt = next_attempt++;
+			if (num_attempts <= attempt) return;
+
+			RandomCallback cb(proto);
+			cb.collector = nullptr;
+			cb.seed_attempts(seed, attempt, 1);
+
+			HandleSeq found;
+			try
+			{
+				Aggregate ag(_as);
+				ag.aggregate(nuclei, cb);
+				found = cb.get_solutions()->getOutgoingSet();
+			}
+			catch (...)
+			{
+				// Stop everyone; the first failure is rethrown below.
+				std::lock_guard<std::mutex> lck(mtx);
+				if (not failure) failure = std::current_exception();
+				enough = true;
+				return;
+			}
+
+			// Fold in every attempt that is now done, in order.
+			std::lock_guard<std::mutex> lck(mtx);
+			pending[attempt] = std::move(found);
+			done[attempt] = true;
+			while (reduced < num_attempts and done[reduced] and not enough)
+			{
+				for (const Handle& soln : pending[reduced])
+				{
+					if (proto.max_solutions <= solns.size()) break;
+					solns.push_back(soln);
+				}
+				pending[reduced].clear();
+				reduced++;
+				if (proto.max_solutions <= solns.size()) enough = true;
+			}
+		}
+	};
+
+	std::vector<std::thread> pool;
+	for (size_t i = 1; i < num_threads; i++)
+		pool.emplace_back(work);
+	work();
+	for (std::thread& thr : pool) thr.join();
+	if (failure) std::rethrow_exception(failure);
+
+	logger().fine("Made %lu attempts on %lu threads, found %lu solutions",
+		reduced, num_threads, solns.size());
+	return solns;
+}
+
+// ========================== END OF FILE ==========================
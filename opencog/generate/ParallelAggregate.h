@@ -0,0 +1,69 @@
+/*
+ * opencog/generate/ParallelAggregate.h
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_PARALLEL_AGGREGATE_H
+#define _OPENCOG_PARALLEL_AGGREGATE_H
+
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/generate/RandomCallback.h>
+
+namespace opencog
+{
+/** \addtogroup grp_generate
+ *  @{
+ */
+
+/// Reproducible random aggregation, on several threads.
+///
+/// Each attempt (a single root draw, aggregated until it is done or
+/// its step budget is spent) is made by a fresh copy of the given
+/// callback, in its own Aggregate, with the random number generator
+/// seeded from the seed and the attempt number. See
+/// `RandomCallback::seed_attempts()`. The attempts are handed out to
+/// the threads in order, and their solutions are gathered in attempt
+/// order, until `max_solutions` have been gathered. Thus, the same
+/// seed gives the same solutions, in the same order, no matter how
+/// many threads are used; only the wall-clock time changes.
+///
+/// The step and size limits of the callback apply to each attempt,
+/// separately. The `RandomParameters` are shared by all of the
+/// threads, and so must not have any mutable state.
+class ParallelAggregate
+{
+private:
+	AtomSpace* _as;
+
+public:
+	ParallelAggregate(AtomSpace*);
+	~ParallelAggregate();
+
+	HandleSeq aggregate(const HandleSet& nuclei,
+	                    const RandomCallback& proto,
+	                    unsigned long seed,
+	                    size_t num_attempts,
+	                    size_t num_threads = 0);
+};
+
+
+/** @}*/
+}  // namespace opencog
+
+#endif // _OPENCOG_PARALLEL_AGGREGATE_H
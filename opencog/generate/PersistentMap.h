@@ -0,0 +1,303 @@
+/*
+ * opencog/generate/PersistentMap.h
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_PERSISTENT_MAP_H
+#define _OPENCOG_PERSISTENT_MAP_H
+
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace opencog
+{
+/** \addtogroup grp_generate
+ *  @{
+ */
+
+/// Ordered map with structural sharing.
+///
+/// The map is a treap, built out of immutable, reference-counted
+/// nodes. Inserting or erasing copies only the path from the root
+/// down to the changed node; all other nodes are shared with the
+/// earlier version of the map. Copying a map copies one pointer, and
+/// so taking a snapshot is O(1), and old snapshots remain valid no
+/// matter what is done to the copy.
+///
+/// The treap priorities are taken from the hash of the key, so that
+/// the shape of the tree depends only on the keys in it, and not on
+/// the order in which they were inserted. Iteration is in key order,
+/// exactly as for `std::map`.
+template<typename Key, typename Value, typename Compare = std::less<Key>>
+class PersistentMap
+{
+public:
+	typedef std::pair<Key, Value> value_type;
+
+private:
+	struct Node;
+	typedef std::shared_ptr<const Node> NodePtr;
+
+	struct Node
+	{
+		value_type kv;
+		size_t prio;
+		NodePtr left;
+		NodePtr right;
+
+		Node(const value_type& v, size_t p,
+		     const NodePtr& l, const NodePtr& r) :
+			kv(v), prio(p), left(l), right(r) {}
+	};
+
+	NodePtr _root;
+	size_t _size;
+
+	static bool less(const Key& a, const Key& b) { return Compare()(a, b); }
+
+	/// Mix the bits of the hash; plain hashes (e.g. of integers)
+	/// would give a degenerate, list-shaped tree.
+	static size_t priority(const Key& key)
+	{
+		uint64_t z = std::hash<Key>()(key) + 0x9e3779b97f4a7c15ULL;
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+		return z ^ (z >> 31);
+	}
+
+	static NodePtr node(const value_type& kv, size_t prio,
+	                    const NodePtr& left, const NodePtr& right)
+	{
+		return std::make_shared<const Node>(kv, prio, left, right);
+	}
+
+	static NodePtr insert(const NodePtr& t, const value_type& kv,
+	                      size_t prio, bool& added)
+	{
+		if (nullptr == t)
+		{
+			added = true;
+			return node(kv, prio, nullptr, nullptr);
+		}
+
+		if (less(kv.first, t->kv.first))
+		{
+			NodePtr l = insert(t->left, kv, prio, added);
+			if (t->prio < l->prio)
+				return node(l->kv, l->prio, l->left,
+					node(t->kv, t->prio, l->right, t->right));
+			return node(t->kv, t->prio, l, t->right);
+		}
+
+		if (less(t->kv.first, kv.first))
+		{
+			NodePtr r = insert(t->right, kv, prio, added);
+			if (t->prio < r->prio)
+				return node(r->kv, r->prio,
+					node(t->kv, t->prio, t->left, r->left), r->right);
+			return node(t->kv, t->prio, t->left, r);
+		}
+
+		// Already present; replace the value.
+		added = false;
+		return node(kv, t->prio, t->left, t->right);
+	}
+
+	/// Join two trees; all keys in `a` are less than those in `b`.
+	static NodePtr merge(const NodePtr& a, const NodePtr& b)
+	{
+		if (nullptr == a) return b;
+		if (nullptr == b) return a;
+		if (b->prio < a->prio)
+			return node(a->kv, a->prio, a->left, merge(a->right, b));
+		return node(b->kv, b->prio, merge(a, b->left), b->right);
+	}
+
+	static NodePtr erase(const NodePtr& t, const Key& key, bool& removed)
+	{
+		if (nullptr == t)
+		{
+			removed = false;
+			return t;
+		}
+
+		if (less(key, t->kv.first))
+		{
+			NodePtr l = erase(t->left, key, removed);
+			if (not removed) return t;
+			return node(t->kv, t->prio, l, t->right);
+		}
+
+		if (less(t->kv.first, key))
+		{
+			NodePtr r = erase(t->right, key, removed);
+			if (not removed) return t;
+			return node(t->kv, t->prio, t->left, r);
+		}
+
+		removed = true;
+		return merge(t->left, t->right);
+	}
+
+	const Node* lookup(const Key& key) const
+	{
+		const Node* t = _root.get();
+		while (t)
+		{
+			if (less(key, t->kv.first)) t = t->left.get();
+			else if (less(t->kv.first, key)) t = t->right.get();
+			else return t;
+		}
+		return nullptr;
+	}
+
+public:
+	PersistentMap() : _size(0) {}
+
+	/// In-order iterator. It is valid for as long as the map (or any
+	/// copy of it) that it was taken from is unchanged.
+	class const_iterator
+	{
+		friend class PersistentMap;
+		std::vector<const Node*> _path;
+
+		void descend(const Node* t)
+		{
+			for (; t; t = t->left.get()) _path.push_back(t);
+		}
+
+	public:
+		typedef std::forward_iterator_tag iterator_category;
+		typedef typename PersistentMap::value_type value_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef const value_type* pointer;
+		typedef const value_type& reference;
+
+		const value_type& operator*() const { return _path.back()->kv; }
+		const value_type* operator->() const { return &_path.back()->kv; }
+
+		const_iterator& operator++()
+		{
+			const Node* t = _path.back();
+			_path.pop_back();
+			descend(t->right.get());
+			return *this;
+		}
+
+		bool operator==(const const_iterator& other) const {
+			if (_path.empty() or other._path.empty())
+				return _path.empty() == other._path.empty();
+			return _path.back() == other._path.back();
+		}
+		bool operator!=(const const_iterator& other) const {
+			return not (*this == other);
+		}
+	};
+
+	const_iterator begin() const
+	{
+		const_iterator it;
+		it.descend(_root.get());
+		return it;
+	}
+	const_iterator end() const { return const_iterator(); }
+
+	size_t size() const { return _size; }
+	bool empty() const { return 0 == _size; }
+	void clear() { _root = nullptr; _size = 0; }
+
+	bool contains(const Key& key) const { return nullptr != lookup(key); }
+
+	/// Return the value for `key`, or `dflt` if it is absent.
+	/// (The same signature as `Counter::get()`.)
+	const Value& get(const Key& key, const Value& dflt) const
+	{
+		const Node* t = lookup(key);
+		return t ? t->kv.second : dflt;
+	}
+
+	/// Set the value for `key`. Returns true if the key was not
+	/// present before.
+	bool set(const Key& key, const Value& value)
+	{
+		bool added;
+		_root = insert(_root, value_type(key, value), priority(key), added);
+		if (added) _size++;
+		return added;
+	}
+
+	/// Remove `key`. Returns the number of entries removed.
+	size_t erase(const Key& key)
+	{
+		bool removed;
+		_root = erase(_root, key, removed);
+		if (not removed) return 0;
+		_size--;
+		return 1;
+	}
+};
+
+/// Ordered set with structural sharing; see `PersistentMap`.
+template<typename Key, typename Compare = std::less<Key>>
+class PersistentSet
+{
+	typedef PersistentMap<Key, bool, Compare> Map;
+	Map _map;
+
+public:
+	class const_iterator
+	{
+		friend class PersistentSet;
+		typename Map::const_iterator _it;
+		const_iterator(const typename Map::const_iterator& it) : _it(it) {}
+
+	public:
+		typedef std::forward_iterator_tag iterator_category;
+		typedef Key value_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef const Key* pointer;
+		typedef const Key& reference;
+
+		const Key& operator*() const { return _it->first; }
+		const Key* operator->() const { return &_it->first; }
+		const_iterator& operator++() { ++_it; return *this; }
+		bool operator==(const const_iterator& o) const { return _it == o._it; }
+		bool operator!=(const const_iterator& o) const { return _it != o._it; }
+	};
+
+	const_iterator begin() const { return const_iterator(_map.begin()); }
+	const_iterator end() const { return const_iterator(_map.end()); }
+
+	size_t size() const { return _map.size(); }
+	bool empty() const { return _map.empty(); }
+	void clear() { _map.clear(); }
+
+	bool contains(const Key& key) const { return _map.contains(key); }
+	bool insert(const Key& key) { return _map.set(key, true); }
+	size_t erase(const Key& key) { return _map.erase(key); }
+};
+
+/** @}*/
+}  // namespace opencog
+
+#endif // _OPENCOG_PERSISTENT_MAP_H
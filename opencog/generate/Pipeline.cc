@@ -0,0 +1,154 @@
+/*
+ * opencog/generate/Pipeline.cc
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+#include <opencog/util/Logger.h>
+
+#include "Aggregate.h"
+#include "BoundedQueue.h"
+#include "Pipeline.h"
+
+using namespace opencog;
+
+Pipeline::Pipeline(AtomSpace* as, size_t capacity) :
+	_as(as), _capacity(capacity),
+	_filter_threads(1), _analyzer_threads(1)
+{
+}
+
+Pipeline::~Pipeline() {}
+
+void Pipeline::set_filter(Filter filt, size_t nthreads)
+{
+	_filter = filt;
+	_filter_threads = (0 < nthreads) ? nthreads : 1;
+}
+
+void Pipeline::set_analyzer(Analyzer anal, size_t nthreads)
+{
+	_analyzer = anal;
+	_analyzer_threads = (0 < nthreads) ? nthreads : 1;
+}
+
+void Pipeline::set_exporter(Exporter exp)
+{
+	_exporter = exp;
+}
+
+size_t Pipeline::run(const HandleSet& nuclei, GenerateCallback& cb)
+{
+	BoundedQueue<Network> generated(_capacity);
+	BoundedQueue<Network> filtered(_capacity);
+	BoundedQueue<Network> analyzed(_capacity);
+	Aggregate ag(_as);
+
+	// On failure, stop everything. The queues are closed, so that
+	// no stage is left waiting on another.
+	std::mutex mtx;
+	std::exception_ptr failure;
+	auto fail = [&](void)
+	{
+		{
+			std::lock_guard<std::mutex> lck(mtx);
+			if (not failure) failure = std::current_exception();
+		}
+		ag.cancel();
+		generated.close();
+		filtered.close();
+		analyzed.close();
+	};
+
+	// Each thread of a stage takes networks from `in`, and passes on
+	// those that `work` returns true for. The last thread of the stage
+	// to finish closes `out`, letting the next stage finish in turn.
+	typedef std::function<bool(Network&)> Work;
+	auto stage = [&](BoundedQueue<Network>& in, BoundedQueue<Network>* out,
+	                 Work work, std::atomic<size_t>& live)
+	{
+		try
+		{
+			Network net;
+			while (in.pop(net))
+			{
+				if (not work(net)) continue;
+				if (out and not out->push(std::move(net))) break;
+			}
+		}
+		catch (...) { fail(); }
+		if (0 == --live and out) out->close();
+	};
+
+	Work filter = [&](Network& net) {
+		return not _filter or _filter(net);
+	};
+	Work analyze = [&](Network& net) {
+		if (_analyzer) _analyzer(net);
+		return true;
+	};
+	std::atomic<size_t> exported(0);
+	Work exprt = [&](Network& net) {
+		if (_exporter) _exporter(std::move(net));
+		exported++;
+		return false;
+	};
+
+	std::atomic<size_t> live_filters(_filter_threads);
+	std::atomic<size_t> live_analyzers(_analyzer_threads);
+	std::atomic<size_t> live_exporters(1);
+
+	std::vector<std::thread> threads;
+	for (size_t i = 0; i < _filter_threads; i++)
+		threads.emplace_back(stage, std::ref(generated), &filtered,
+			filter, std::ref(live_filters));
+	for (size_t i = 0; i < _analyzer_threads; i++)
+		threads.emplace_back(stage, std::ref(filtered), &analyzed,
+			analyze, std::ref(live_analyzers));
+	threads.emplace_back(stage, std::ref(analyzed), nullptr,
+		exprt, std::ref(live_exporters));
+
+	// Generate, here and now, feeding the first queue.
+	std::function<void(HandleSet&&)> saved_stream = cb.stream;
+	cb.stream = [&](HandleSet&& sects)
+	{
+		Network net;
+		net.sections = std::move(sects);
+		generated.push(std::move(net));
+	};
+	try
+	{
+		ag.aggregate(nuclei, cb);
+	}
+	catch (...) { fail(); }
+	cb.stream = saved_stream;
+	generated.close();
+
+	for (std::thread& thr : threads) thr.join();
+	if (failure) std::rethrow_exception(failure);
+
+	logger().fine("Pipeline exported %lu networks", exported.load());
+	return exported;
+}
+
+// ========================== END OF FILE ==========================
@@ -0,0 +1,99 @@
+/*
+ * opencog/generate/Pipeline.h
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_PIPELINE_H
+#define _OPENCOG_PIPELINE_H
+
+#include <functional>
+#include <map>
+#include <string>
+
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/generate/GenerateCallback.h>
+
+namespace opencog
+{
+/** \addtogroup grp_generate
+ *  @{
+ */
+
+/// A network passing through the pipeline: the sections of one
+/// solution, and whatever metrics the analysis stage attaches to it.
+struct Network
+{
+	HandleSet sections;
+	std::map<std::string, double> metrics;
+};
+
+/// Generate networks, filter them, analyze them and export them, with
+/// all four stages running at the same time.
+///
+/// The aggregation runs on the calling thread; each solution is handed
+/// on as soon as it is found. The filter and analysis stages each run
+/// on as many threads as requested, and the export stage runs on one
+/// thread, so that the exporter need not be thread-safe. The stages are
+/// connected by bounded queues: when a later stage falls behind, the
+/// queues fill up, and the earlier stages (including the aggregation
+/// itself) wait. Networks are moved from stage to stage, not copied.
+///
+/// If any stage throws, the aggregation is cancelled, the pipeline is
+/// drained, and the exception is rethrown by `run()`.
+///
+/// The sections of the networks live in the scratch AtomSpace of the
+/// aggregation, which goes away when `run()` returns. The exporter
+/// must copy out anything that it wants to keep.
+class Pipeline
+{
+public:
+	/// Return true to pass the network on, false to drop it.
+	typedef std::function<bool(const Network&)> Filter;
+	typedef std::function<void(Network&)> Analyzer;
+	typedef std::function<void(Network&&)> Exporter;
+
+private:
+	AtomSpace* _as;
+	size_t _capacity;
+
+	Filter _filter;
+	size_t _filter_threads;
+	Analyzer _analyzer;
+	size_t _analyzer_threads;
+	Exporter _exporter;
+
+public:
+	/// `capacity` is the number of networks that each queue can hold.
+	Pipeline(AtomSpace*, size_t capacity = 16);
+	~Pipeline();
+
+	void set_filter(Filter, size_t nthreads = 1);
+	void set_analyzer(Analyzer, size_t nthreads = 1);
+	void set_exporter(Exporter);
+
+	/// Run the pipeline until the aggregation is done. Returns the
+	/// number of networks that were exported.
+	size_t run(const HandleSet& nuclei, GenerateCallback&);
+};
+
+
+/** @}*/
+}  // namespace opencog
+
+#endif // _OPENCOG_PIPELINE_H
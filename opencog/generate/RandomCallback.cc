@@ -28,11 +28,25 @@
 
 using namespace opencog;
 
+/// Number of times to draw a piece from the lexis, before accepting
+/// it regardless of what the parameters say. See `accept_arity()`.
+static const size_t max_arity_tries = 12;
+
 RandomCallback::RandomCallback(AtomSpace* as, const Dictionary& dict,
                                RandomParameters& parms) :
 	GenerateCallback(as), _dict(dict), _parms(&parms)
 {
 	_steps_taken = 0;
+	_attempt = 0;
+	_attempt_steps = 0;
+	_rooted = false;
+
+	std::random_device seed;
+	_rangen.seed(seed());
+	_seeded = false;
+	_seed = 0;
+	_first_attempt = 0;
+	_end_attempt = SIZE_MAX;
 
 	max_solutions = 100;
 
@@ -45,20 +59,23 @@ RandomCallback::RandomCallback(AtomSpace* as, const Dictionary& dict,
 
 RandomCallback::~RandomCallback() {}
 
-static std::random_device seed;
-static std::mt19937 rangen(seed());
-
 void RandomCallback::clear(AtomSpace* scratch)
 {
-	while (not _opensel_stack.empty()) _opensel_stack.pop();
-	_opensel._opensect.clear();
-	_opensel._opendi.clear();
+	while (not _trail_marks.empty()) _trail_marks.pop();
+	_trail.clear();
+	_open_samplers.clear();
 
 	_root_sections.clear();
 	_root_dist.clear();
 	_distmap.clear();
 	_steps_taken = 0;
+	_attempt = _first_attempt;
+	_attempt_steps = 0;
+	_rooted = false;
 	CollectStyle::clear();
+	CollectStyle::_isomorphic = dedupe_isomorphic;
+	CollectStyle::_collector = collector;
+	CollectStyle::_stream = stream;
 	LinkStyle::clear();
 	LinkStyle::_point_set = point_set;
 	LinkStyle::_scratch = scratch;
@@ -82,18 +99,40 @@ void RandomCallback::root_set(const HandleSet& roots)
 		// hanging off the section (in a FloatValue).
 		std::vector<double> pdf;
 		for (const Handle& sect: sects)
-		{
-			FloatValuePtr fvp(FloatValueCast(sect->getValue(_weight_key)));
-			if (fvp)
-				pdf.push_back(fvp->value()[0]);
-			else
-				pdf.push_back(0.0);
-		}
+			pdf.push_back(lexis_weight(sect));
 		std::discrete_distribution<size_t> dist(pdf.begin(), pdf.end());
 		_root_dist.push_back(dist);
 	}
 }
 
+/// Make the attempts from `first` up to `first+count` (each attempt
+/// being one root draw), with the random number generator reseeded
+/// from `seed` and the attempt number at the start of each. The
+/// networks drawn in an attempt then depend only on the seed and the
+/// attempt number, and not on which other attempts were made, or
+/// where. The unique point names are made from the seed and attempt
+/// number, too, instead of being UUID's.
+void RandomCallback::seed_attempts(unsigned long seed,
+                                   size_t first, size_t count)
+{
+	_seeded = true;
+	_seed = seed;
+	_first_attempt = first;
+	_end_attempt = (SIZE_MAX - first < count) ? SIZE_MAX : first + count;
+}
+
+void RandomCallback::seed_attempt(void)
+{
+	uint64_t sd = _seed;
+	uint64_t at = _attempt;
+	std::seed_seq seq{(uint32_t) sd, (uint32_t) (sd >> 32),
+	                  (uint32_t) at, (uint32_t) (at >> 32)};
+	_rangen.seed(seq);
+
+	LinkStyle::_id_prefix = std::to_string(_seed) + "." + std::to_string(_attempt);
+	LinkStyle::_id_count = 0;
+}
+
 /// Perform a random draw of root sections.
 HandleSet RandomCallback::next_root(void)
 {
@@ -105,11 +144,25 @@ HandleSet RandomCallback::next_root(void)
 	if (max_steps < _steps_taken) return empty_set;
 	if (max_solutions <= num_solutions()) return empty_set;
 
+	// Start a new attempt. The first call does not count as
+	// a restart.
+	if (_rooted)
+	{
+		logger().fine("Restart after %lu steps on attempt %lu",
+			_attempt_steps, _attempt);
+		_attempt ++;
+	}
+	_rooted = true;
+	_attempt_steps = 0;
+
+	if (_end_attempt <= _attempt) return empty_set;
+	if (_seeded) seed_attempt();
+
 	// Random drawing.
 	HandleSet starters;
 	for (size_t i=0; i<len; i++)
 	{
-		size_t idx = _root_dist[i](rangen);
+		size_t idx = _root_dist[i](_rangen);
 		Handle root(_root_sections[i][idx]);
 		starters.insert(create_unique_section(root));
 	}
@@ -129,32 +182,38 @@ Handle RandomCallback::select_from_lexis(const Frame& frame,
 	if (0 == to_sects.size()) return Handle::UNDEFINED;
 
 	// Do we have a chooser for the to-connector?
-	// If so, then use to pick a section, randomly.
+	// If not, then create one.
 	auto curit = _distmap.find(to_con);
-	if (_distmap.end() != curit)
+	if (_distmap.end() == curit)
 	{
-		auto dist = curit->second;
-		return create_unique_section(to_sects[dist(rangen)]);
+		// Create a discrete distribution. This will randomly pick an
+		// index into the `to_sects` array. The weight of each index
+		// is given by the pdf aka "probability distribution function".
+		// The pdf is just given by the weighting-key hanging off the
+		// section (in a FloatValue).
+		std::vector<double> pdf;
+		for (const Handle& sect: to_sects)
+			pdf.push_back(lexis_weight(sect));
+		std::discrete_distribution<size_t> dist(pdf.begin(), pdf.end());
+		curit = _distmap.emplace(std::make_pair(to_con, dist)).first;
 	}
 
-	// Create a discrete distribution. This will randomly pick an
-	// index into the `to_sects` array. The weight of each index
-	// is given by the pdf aka "probability distribution function".
-	// The pdf is just given by the weighting-key hanging off the
-	// section (in a FloatValue).
-	std::vector<double> pdf;
-	for (const Handle& sect: to_sects)
+	// Pick a section, randomly. The parameters may reject it, based
+	// on its arity; if so, draw again. Give up after a few tries, so
+	// as not to loop forever when everything is rejected.
+	std::uniform_real_distribution<> unit(0.0, 1.0);
+	auto& dist = curit->second;
+	size_t idx = dist(_rangen);
+	for (size_t tries = 1; tries < max_arity_tries; tries++)
 	{
-		FloatValuePtr fvp(FloatValueCast(sect->getValue(_weight_key)));
-		if (fvp)
-			pdf.push_back(fvp->value()[0]);
-		else
-			pdf.push_back(0.0);
+		size_t arity = to_sects[idx]->getOutgoingAtom(1)->get_arity();
+		double accept = _parms->accept_arity(frame, max_network_size,
+		                                     arity);
+		if (1.0 <= accept or unit(_rangen) < accept) break;
+		idx = dist(_rangen);
 	}
-	std::discrete_distribution<size_t> dist(pdf.begin(), pdf.end());
-	_distmap.emplace(std::make_pair(to_con, dist));
 
-	return create_unique_section(to_sects[dist(rangen)]);
+	return create_unique_section(to_sects[idx]);
 }
 
 /// Return a section containing `to_con`, from the set of currently
@@ -162,97 +221,48 @@ Handle RandomCallback::select_from_lexis(const Frame& frame,
 ///
 /// Examine the set of currently-unconnected connectors. If any of
 /// them are connectable to `to_con`, then randomly pick one of the
-/// sections, and return that. Otherwise return the undefined handle.
+/// sections, in proportion to the weight of the lexis section that
+/// it came from, and return that. Otherwise return the undefined
+/// handle.
 ///
 /// This disallows self-connections (the from and to-sections being the
 /// same) unless the parameters allow it.
-//
-// This just sets up a list of candidates; the actual picking is done
-// by `do_select_one()`.
 Handle RandomCallback::select_from_open(const Frame& frame,
                                const Handle& fm_sect, size_t offset,
                                const Handle& to_con)
 {
-	// XXX FIXME -- this implements a cache of distributions
-	// ... which are kept on a stack ... this could be RAM intensive
-	// ... and also CPU intensive. It might be faster to just
-	// choose on the fly, yeah? Don't know... needs investigation.
-
 	// Are there any attachable connectors?
-	auto tosit = _opensel._opensect.find(to_con);
-	if (_opensel._opensect.end() != tosit and tosit->second.size() == 0)
-		return Handle::UNDEFINED;
-
-	// If there's only one, pick it.
-	const HandleSeq& to_seclist = tosit->second;
-	if (to_seclist.size() == 1)
-		return to_seclist[0];
-
-	// Do we have a chooser for the to-connector in the current frame?
-	// If so, then use it.
-	auto curit = _opensel._opendi.find(to_con);
-	if (_opensel._opendi.end() != curit)
-	{
-		auto dist = curit->second;
-		return to_seclist[dist(rangen)];
-	}
+	auto sit = _open_samplers.find(to_con);
+	if (_open_samplers.end() == sit) return Handle::UNDEFINED;
+	SectionSampler& sampler = sit->second;
 
-	// Create a list of connectable sections
+	// Draw sections until one is found that can be connected to.
+	// Those that cannot are set aside, and put back afterwards.
+	std::uniform_real_distribution<> unit(0.0, 1.0);
 	const Handle& linkty = to_con->getOutgoingAtom(0);
-	HandleSeq to_sects;
-	for (const Handle& open_sect : frame._open_sections)
+	std::vector<std::pair<Handle, double>> aside;
+	Handle to_sect;
+	while (0 < sampler.live())
 	{
-		if (not allow_self_connections and open_sect == fm_sect)
-			continue;
-
-		const Handle& conseq = open_sect->getOutgoingAtom(1);
-		for (const Handle& con : conseq->getOutgoingSet())
-		{
-			if (*con == *to_con)
-			{
-				// Wait, are these already connected?
-				if (pair_any_links <= num_any_links(fm_sect, open_sect))
-					continue;
-				if (1 < pair_any_links and
-				    pair_typed_links <= num_undirected_links(fm_sect,
-				                                  open_sect, linkty))
-					continue;
-				to_sects.push_back(open_sect);
-			}
-		}
+		Handle open_sect = sampler.sample(unit(_rangen));
+
+		// Wait, are these already connected?
+		bool ok = allow_self_connections or open_sect != fm_sect;
+		if (ok and pair_any_links <= num_any_links(fm_sect, open_sect))
+			ok = false;
+		if (ok and 1 < pair_any_links and
+		    pair_typed_links <= num_undirected_links(fm_sect,
+		                                  open_sect, linkty))
+			ok = false;
+
+		if (ok) { to_sect = open_sect; break; }
+		aside.push_back({open_sect, sampler.remove(open_sect)});
 	}
 
-	// Save it...
-	_opensel._opensect[to_con] = to_sects;
-
-	// Oh no, dead end!
-	if (0 == to_sects.size()) return Handle::UNDEFINED;
+	for (const auto& pr : aside)
+		sampler.insert(pr.first, pr.second);
 
-	// There's only one. Pick it.
-	if (1 == to_sects.size()) return to_sects[0];
-
-	// Create a discrete distribution.
-	// Argh ... XXX FIXME ... the aggregator does NOT copy
-	// values onto the assembled linkage, and so these will
-	// always fail to have the weight key on them. That's OK,
-	// for now, because copying the values it probably wasteful.
-	// but still ... this results in a uniform distribution,
-	// and so its ... ick. Imperfect. Perfect enemy of the good.
-#if 0
-	std::vector<double> pdf;
-	for (const Handle& sect: to_sects)
-	{
-		FloatValuePtr fvp(FloatValueCast(sect->getValue(_weight_key)));
-		if (fvp) pdf.push_back(fvp->value()[0]);
-		else pdf.push_back(1.0);
-	}
-#else
-	std::vector<double> pdf(to_sects.size(), 1.0);
-#endif
-	std::discrete_distribution<size_t> dist(pdf.begin(), pdf.end());
-	_opensel._opendi.emplace(std::make_pair(to_con, dist));
-
-	return to_sects[dist(rangen)];
+	return to_sect;
 }
 
 /// Return a section containing `to_con`.
@@ -263,7 +273,12 @@ Handle RandomCallback::select(const Frame& frame,
                               const Handle& to_con)
 {
 	// See if we can find other open connectors to connect to.
-	if (_parms->connect_existing(frame))
+	// Links that must close a cycle always try to.
+	std::uniform_real_distribution<> unit(0.0, 1.0);
+	const Handle& fm_con = fm_sect->getOutgoingAtom(1)->getOutgoingAtom(offset);
+	if (0 < must_close.count({fm_con, to_con}) or
+	    0 < must_close.count({to_con, fm_con}) or
+	    unit(_rangen) < _parms->connect_existing(frame, max_network_size))
 	{
 		Handle open_sect = select_from_open(frame, fm_sect, offset, to_con);
 		if (open_sect) return open_sect;
@@ -293,25 +308,87 @@ size_t RandomCallback::num_links(const Handle& fm_sect,
 	return num_undirected_links(fm_sect, to_sect, link_type);
 }
 
+/// Return the weight of the lexis section `sect`. Sections without a
+/// weight get a weight of one, whether they are drawn as roots, from
+/// the lexis, or from the open sections; if none of them have weights,
+/// every draw is uniform.
+double RandomCallback::lexis_weight(const Handle& sect)
+{
+	if (nullptr == _weight_key) return 1.0;
+
+	FloatValuePtr fvp(FloatValueCast(sect->getValue(_weight_key)));
+	if (fvp) return fvp->value()[0];
+	return 1.0;
+}
+
+/// Return the weight of the lexis section that `sect` was made from.
+double RandomCallback::section_weight(const Handle& sect)
+{
+	Handle origin(lexis_origin(sect));
+	if (nullptr == origin) return 1.0;
+	return lexis_weight(origin);
+}
+
+/// Add `sect` to the chooser for each kind of connector in it.
+void RandomCallback::open_section(const Handle& sect)
+{
+	double weight = section_weight(sect);
+	for (const Handle& con : sect->getOutgoingAtom(1)->getOutgoingSet())
+	{
+		if (CONNECTOR != con->get_type()) continue;
+
+		SectionSampler& sampler = _open_samplers[con];
+		if (sampler.contains(sect)) continue;
+		sampler.insert(sect, weight);
+		_trail.push_back({con, sect, weight, true});
+	}
+}
+
+/// Remove `sect` from the choosers.
+void RandomCallback::close_section(const Handle& sect)
+{
+	for (const Handle& con : sect->getOutgoingAtom(1)->getOutgoingSet())
+	{
+		if (CONNECTOR != con->get_type()) continue;
+
+		auto sit = _open_samplers.find(con);
+		if (_open_samplers.end() == sit) continue;
+		if (not sit->second.contains(sect)) continue;
+		double weight = sit->second.remove(sect);
+		_trail.push_back({con, sect, weight, false});
+	}
+}
+
 void RandomCallback::push_frame(const Frame& frm)
 {
-	_opensel_stack.push(_opensel);
-	_opensel._opensect.clear();
-	_opensel._opendi.clear();
+	_trail_marks.push(_trail.size());
 }
 
+/// Undo all of the changes made to the choosers since the push.
 void RandomCallback::pop_frame(const Frame& frm)
 {
-	_opensel = _opensel_stack.top(); _opensel_stack.pop();
+	size_t mark = _trail_marks.top(); _trail_marks.pop();
+	while (mark < _trail.size())
+	{
+		const TrailEntry& ent = _trail.back();
+		SectionSampler& sampler = _open_samplers[ent.con];
+		if (ent.opened)
+			sampler.remove(ent.sect);
+		else
+			sampler.insert(ent.sect, ent.weight);
+		_trail.pop_back();
+	}
 }
 
 bool RandomCallback::step(const Frame& frm)
 {
 	_steps_taken ++;
+	_attempt_steps ++;
 	if (max_steps < _steps_taken) return false;
 	if (max_solutions <= num_solutions()) return false;
+	if (_parms->attempt_steps(_attempt) < _attempt_steps) return false;
 	if (max_network_size < frm._linkage.size()) return false;
-	if (max_depth < frm._nodo) return false;
+	if (max_depth < frm._nodo or max_depth < frm._reach) return false;
 	return true;
 	// return _parms->step(frm);
 }
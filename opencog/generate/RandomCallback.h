@@ -22,11 +22,14 @@
 #ifndef _OPENCOG_RANDOM_CALLBACK_H
 #define _OPENCOG_RANDOM_CALLBACK_H
 
+#include <random>
+
 #include <opencog/generate/CollectStyle.h>
 #include <opencog/generate/Dictionary.h>
 #include <opencog/generate/GenerateCallback.h>
 #include <opencog/generate/LinkStyle.h>
 #include <opencog/generate/RandomParameters.h>
+#include <opencog/generate/SectionSampler.h>
 
 namespace opencog
 {
@@ -50,6 +53,23 @@ private:
 	Handle _weight_key;
 	size_t _steps_taken;
 
+	/// The number of roots drawn so far, and the number of steps
+	/// taken since the last root was drawn. Used to restart.
+	size_t _attempt;
+	size_t _attempt_steps;
+	bool _rooted;
+
+	/// Random number generator. If `_seeded` is set, it is reseeded
+	/// from `_seed` and the attempt number at the start of each
+	/// attempt, and only the attempts from `_first_attempt` up to (but
+	/// not including) `_end_attempt` are made. See `seed_attempts()`.
+	std::mt19937 _rangen;
+	bool _seeded;
+	unsigned long _seed;
+	size_t _first_attempt;
+	size_t _end_attempt;
+	void seed_attempt(void);
+
 	// -------------------------------------------
 	// Nucleation points.
 	HandleSeqSeq _root_sections;
@@ -70,16 +90,24 @@ private:
 	Handle select_from_open(const Frame&,
 	                        const Handle&, size_t,
 	                        const Handle&);
-	struct OpenSelections
-	{
-		HandleSeqMap _opensect;
 
-		// Chooser, selecting a one of the open sections the current frame.
-		std::map<Handle, std::discrete_distribution<size_t>> _opendi;
+	// Map from connectors to weighted choosers of the open sections
+	// of the current frame holding that connector. These are updated
+	// as sections are opened and closed. Each change is recorded on
+	// a trail, so that it can be undone when the frame is popped.
+	std::map<Handle, SectionSampler> _open_samplers;
+	struct TrailEntry
+	{
+		Handle con;
+		Handle sect;
+		double weight;
+		bool opened;
 	};
+	std::vector<TrailEntry> _trail;
+	std::stack<size_t> _trail_marks;
 
-	OpenSelections _opensel;
-	std::stack<OpenSelections> _opensel_stack;
+	double lexis_weight(const Handle&);
+	double section_weight(const Handle&);
 	// -------------------------------------------
 
 public:
@@ -87,14 +115,21 @@ public:
 	virtual ~RandomCallback();
 
 	virtual void clear(AtomSpace*);
+	void set_parameters(RandomParameters& parms) { _parms = &parms; }
 	void set_weight_key(const Handle& pred) { _weight_key = pred; }
+	void seed(unsigned long s) { _rangen.seed(s); }
+	void seed_attempts(unsigned long, size_t first = 0,
+	                   size_t count = SIZE_MAX);
 
 	virtual void root_set(const HandleSet&);
 	virtual HandleSet next_root(void);
 
-	virtual HandleSeq joints(const Handle& con) {
+	virtual const HandleSeq& joints(const Handle& con) {
 		return _dict.joints(con);
 	}
+	virtual size_t min_to_close(const Frame& frm) {
+		return _dict.min_to_close(frm._open_cons);
+	}
 	virtual Handle select(const Frame&,
 	                      const Handle&, size_t,
 	                      const Handle&);
@@ -103,12 +138,17 @@ public:
 	                         const Handle&, const Handle&);
 	virtual size_t num_links(const Handle&, const Handle&,
 	                         const Handle&);
+	virtual void open_section(const Handle&);
+	virtual void close_section(const Handle&);
 	virtual void push_frame(const Frame&);
 	virtual void pop_frame(const Frame&);
 
 	virtual bool step(const Frame&);
 	virtual void solution(const Frame&);
 	virtual Handle get_solutions(void);
+	virtual void visit_solutions(const SolutionVisitor& visit) {
+		CollectStyle::visit_solutions(visit);
+	}
 };
 
 
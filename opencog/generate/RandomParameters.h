@@ -41,17 +41,36 @@ public:
 	RandomParameters() {}
 	virtual ~RandomParameters() {}
 
-	/// Return true attempt connecting a pair of existing open sections,
-	/// else return false to fish for a new, fresh puzzle-piece out of
-	/// the lexis. Consistently returning true will maximally close off
-	/// any open connectors without enlarging the network. Rturning false
-	/// will always increase the size of the network.
-	virtual bool connect_existing(const Frame&) = 0;
+	/// Return the probability of attempting to connect a pair of
+	/// existing open sections, rather than fishing for a new, fresh
+	/// puzzle-piece out of the lexis. Consistently returning one will
+	/// maximally close off any open connectors without enlarging the
+	/// network. Returning zero will always increase the size of the
+	/// network. The draw itself is made by the callback, with its own
+	/// random number generator, so that parameters hold no random state,
+	/// and can be shared by callbacks running on different threads.
+	/// For the same reason, `max_size` is the `max_network_size` of
+	/// the callback that is asking.
+	virtual double connect_existing(const Frame&, size_t max_size) = 0;
+
+	/// Return the probability of accepting a fresh puzzle-piece having
+	/// `arity` connectors, drawn from the lexis. If it is not accepted,
+	/// another piece is drawn. The default accepts all pieces, so that
+	/// they are drawn in proportion to their weights.
+	virtual double accept_arity(const Frame&, size_t max_size,
+	                            size_t arity) { return 1.0; }
 
 	/// Return true to continue stepping the odometer. Called before
 	/// taking an odometer step.  Returning false will abort the
 	/// current odometer.
 	virtual bool step(const Frame&) = 0;
+
+	/// Return the number of steps that may be taken, when building
+	/// a network from the `attempt`'th root (counting from zero).
+	/// After that many steps, the attempt is abandoned, and a fresh
+	/// root is drawn; i.e. the search is restarted. The default is
+	/// to never restart.
+	virtual size_t attempt_steps(size_t attempt) { return SIZE_MAX; }
 };
 
 
@@ -0,0 +1,134 @@
+/*
+ * opencog/generate/SectionSampler.cc
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "SectionSampler.h"
+
+using namespace opencog;
+
+SectionSampler::SectionSampler(void) : _live(0)
+{
+}
+
+/// Add `delta` to the weight in slot `slot`.
+void SectionSampler::adjust(size_t slot, double delta)
+{
+	for (size_t i = slot + 1; i < _tree.size(); i += i & (~i + 1))
+		_tree[i] += delta;
+}
+
+/// Double the number of slots, and rebuild the tree. The rebuild is
+/// done in linear time, and also clears out any rounding errors that
+/// have crept into the partial sums.
+void SectionSampler::grow(void)
+{
+	size_t old = _weight.size();
+	size_t cap = (0 == old) ? 8 : 2 * old;
+
+	_weight.resize(cap, 0.0);
+	_sects.resize(cap);
+	for (size_t slot = cap; old < slot; slot--)
+		_free.push_back(slot - 1);
+
+	_tree.assign(cap + 1, 0.0);
+	for (size_t i = 1; i <= cap; i++)
+	{
+		_tree[i] += _weight[i-1];
+		size_t up = i + (i & (~i + 1));
+		if (up <= cap) _tree[up] += _tree[i];
+	}
+}
+
+/// Add the section `sect`, with weight `weight`. Negative weights
+/// are treated as zero. The section must not already be present.
+void SectionSampler::insert(const Handle& sect, double weight)
+{
+	if (weight < 0.0) weight = 0.0;
+	if (_free.empty()) grow();
+
+	size_t slot = _free.back();
+	_free.pop_back();
+
+	_slot[sect] = slot;
+	_sects[slot] = sect;
+	_weight[slot] = weight;
+	adjust(slot, weight);
+	if (0.0 < weight) _live++;
+}
+
+/// Remove the section `sect`. Returns its weight, so that it can be
+/// put back later, if desired.
+double SectionSampler::remove(const Handle& sect)
+{
+	auto sit = _slot.find(sect);
+	if (_slot.end() == sit) return 0.0;
+
+	size_t slot = sit->second;
+	_slot.erase(sit);
+
+	double weight = _weight[slot];
+	adjust(slot, -weight);
+	if (0.0 < weight) _live--;
+
+	_weight[slot] = 0.0;
+	_sects[slot] = Handle::UNDEFINED;
+	_free.push_back(slot);
+	return weight;
+}
+
+double SectionSampler::total(void) const
+{
+	double sum = 0.0;
+	for (size_t i = _tree.size() - 1; 0 < i and i < _tree.size(); i -= i & (~i + 1))
+		sum += _tree[i];
+	return sum;
+}
+
+/// Draw a section, in proportion to its weight. The argument should
+/// be a uniformly distributed random number in the range [0,1).
+/// Returns the undefined handle if there is nothing to draw.
+Handle SectionSampler::sample(double unit) const
+{
+	if (0 == _live) return Handle::UNDEFINED;
+
+	// Descend the tree, looking for the slot where the running
+	// sum first exceeds the target.
+	double target = unit * total();
+	size_t pos = 0;
+	size_t step = 1;
+	while (step <= _weight.size() / 2) step <<= 1;
+	for (; 0 < step; step >>= 1)
+	{
+		size_t next = pos + step;
+		if (next < _tree.size() and _tree[next] <= target)
+		{
+			pos = next;
+			target -= _tree[next];
+		}
+	}
+
+	// Rounding errors might land us on an empty slot. Look for
+	// the nearest occupied one.
+	for (size_t slot = pos; slot < _weight.size(); slot++)
+		if (0.0 < _weight[slot]) return _sects[slot];
+	for (size_t slot = pos; 0 < slot; slot--)
+		if (0.0 < _weight[slot-1]) return _sects[slot-1];
+	return Handle::UNDEFINED;
+}
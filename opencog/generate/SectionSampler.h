@@ -0,0 +1,80 @@
+/*
+ * opencog/generate/SectionSampler.h
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_SECTION_SAMPLER_H
+#define _OPENCOG_SECTION_SAMPLER_H
+
+#include <unordered_map>
+#include <vector>
+
+#include <opencog/atoms/base/Handle.h>
+
+namespace opencog
+{
+/** \addtogroup grp_generate
+ *  @{
+ */
+
+/// Weighted random choice among a changing set of sections.
+///
+/// The weights are kept in a Fenwick (binary indexed) tree, so that
+/// adding a section, removing one, and drawing one at random, in
+/// proportion to its weight, all take O(log n) time. Slots freed by
+/// removed sections are re-used.
+class SectionSampler
+{
+private:
+	/// Fenwick tree of partial sums, indexed from one.
+	std::vector<double> _tree;
+
+	/// The weight and the section in each slot, indexed from zero.
+	std::vector<double> _weight;
+	HandleSeq _sects;
+
+	std::unordered_map<Handle, size_t> _slot;
+	std::vector<size_t> _free;
+
+	/// Number of sections with a non-zero weight.
+	size_t _live;
+
+	void adjust(size_t, double);
+	void grow(void);
+
+public:
+	SectionSampler(void);
+
+	void insert(const Handle&, double);
+	double remove(const Handle&);
+	bool contains(const Handle& sect) const {
+		return _slot.end() != _slot.find(sect);
+	}
+
+	/// Number of sections that can be drawn.
+	size_t live(void) const { return _live; }
+	double total(void) const;
+	Handle sample(double) const;
+};
+
+
+/** @}*/
+}  // namespace opencog
+
+#endif // _OPENCOG_SECTION_SAMPLER_H
@@ -0,0 +1,210 @@
+/*
+ * opencog/generate/Shape.cc
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <functional>
+#include <set>
+
+#include <opencog/atoms/base/Atom.h>
+
+#include "Shape.h"
+
+using namespace opencog;
+
+static inline size_t mix(size_t seed, size_t val)
+{
+	return seed ^ (val + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+}
+
+/// Hash of the point name, with the unique suffix removed.
+size_t Shape::point_key(const Handle& point)
+{
+	static std::hash<std::string> hstr;
+	const std::string& name = point->get_name();
+	return mix(point->get_type(), hstr(name.substr(0, name.rfind('@'))));
+}
+
+/// Hash of the point name, and of the connector sequence, with each
+/// link replaced by its link type.
+size_t Shape::section_key(const Handle& sect)
+{
+	size_t key = point_key(sect->getOutgoingAtom(0));
+	for (const Handle& con : sect->getOutgoingAtom(1)->getOutgoingSet())
+	{
+		if (CONNECTOR == con->get_type())
+			key = mix(key, con->get_hash());
+		else
+			key = mix(mix(key, 1), con->getOutgoingAtom(0)->get_hash());
+	}
+	return key;
+}
+
+/// Hash of the link type, and of the names of the two end-points.
+/// The order of the end-points does not matter.
+size_t Shape::link_key(const Handle& lnk)
+{
+	const HandleSeq& ends = lnk->getOutgoingAtom(1)->getOutgoingSet();
+	size_t ka = point_key(ends[0]);
+	size_t kb = point_key(ends.back());
+	return mix(mix(lnk->getOutgoingAtom(0)->get_hash(),
+		std::min(ka, kb)), std::max(ka, kb));
+}
+
+Shape::Shape(const HandleSet& linkage, bool with_connectors,
+             const HandleSet& pinned)
+{
+	// Number the points.
+	std::map<Handle, size_t> index;
+	std::vector<Handle> points;
+	for (const Handle& sect : linkage)
+	{
+		index[sect->getOutgoingAtom(0)] = points.size();
+		points.push_back(sect->getOutgoingAtom(0));
+	}
+
+	size_t npts = points.size();
+	std::vector<size_t> label;
+	for (const Handle& sect : linkage)
+	{
+		const Handle& point = sect->getOutgoingAtom(0);
+		size_t lab = with_connectors ? section_key(sect) : point_key(point);
+		if (0 < pinned.count(point)) lab = mix(lab, point->get_hash());
+		label.push_back(lab);
+	}
+
+	// Collect the edges. Every link appears in the sections at both
+	// of its ends, so each edge is seen once from each direction.
+	std::vector<std::vector<std::pair<size_t, size_t>>> adj(npts);
+	_num_edges = 0;
+	for (const Handle& sect : linkage)
+	{
+		const Handle& point = sect->getOutgoingAtom(0);
+		size_t from = index[point];
+		for (const Handle& lnk : sect->getOutgoingAtom(1)->getOutgoingSet())
+		{
+			if (CONNECTOR == lnk->get_type()) continue;
+
+			const HandleSeq& ends = lnk->getOutgoingAtom(1)->getOutgoingSet();
+			const Handle& other = (ends[0] == point) ? ends.back() : ends[0];
+			auto oit = index.find(other);
+			if (index.end() == oit) continue;
+
+			size_t elab = lnk->getOutgoingAtom(0)->get_hash();
+			adj[from].push_back({elab, oit->second});
+			_edges[{from, oit->second}].push_back(elab);
+			_num_edges++;
+		}
+	}
+	for (auto& edg : _edges)
+		std::sort(edg.second.begin(), edg.second.end());
+
+	// Refine the colours until the number of colour classes stops
+	// growing. This takes at most one round per point.
+	_color = label;
+	size_t nclasses = std::set<size_t>(_color.begin(), _color.end()).size();
+	for (size_t round = 0; round < npts; round++)
+	{
+		std::vector<size_t> recolor(npts);
+		for (size_t i = 0; i < npts; i++)
+		{
+			std::vector<size_t> nbrs;
+			for (const auto& edge : adj[i])
+				nbrs.push_back(mix(edge.first, _color[edge.second]));
+			std::sort(nbrs.begin(), nbrs.end());
+
+			size_t col = _color[i];
+			for (size_t nc : nbrs) col = mix(col, nc);
+			recolor[i] = col;
+		}
+		_color.swap(recolor);
+
+		size_t nc = std::set<size_t>(_color.begin(), _color.end()).size();
+		if (nc == nclasses) break;
+		nclasses = nc;
+	}
+
+	std::vector<size_t> sorted(_color);
+	std::sort(sorted.begin(), sorted.end());
+	_hash = mix(npts, _num_edges);
+	for (size_t col : sorted) _hash = mix(_hash, col);
+}
+
+/// Extend the partial map `perm` (from points in this shape, to points
+/// in `other`) to the point `order[depth]`, and then recursively to the
+/// remaining points. Return true if a complete isomorphism was found.
+bool Shape::match(const Shape& other, std::vector<size_t>& perm,
+                  std::vector<bool>& used, const std::vector<size_t>& order,
+                  size_t depth) const
+{
+	if (order.size() == depth) return true;
+
+	static const std::vector<size_t> none;
+	auto edges = [](const Shape& shp, size_t a, size_t b)
+		-> const std::vector<size_t>&
+	{
+		auto eit = shp._edges.find({a, b});
+		return (shp._edges.end() == eit) ? none : eit->second;
+	};
+
+	size_t v = order[depth];
+	for (size_t w = 0; w < other._color.size(); w++)
+	{
+		if (used[w] or other._color[w] != _color[v]) continue;
+
+		// The edges to all of the points mapped so far must agree.
+		perm[v] = w;
+		bool ok = true;
+		for (size_t d = 0; d <= depth and ok; d++)
+		{
+			size_t u = order[d];
+			ok = edges(*this, v, u) == edges(other, w, perm[u]);
+		}
+		if (not ok) continue;
+
+		used[w] = true;
+		if (match(other, perm, used, order, depth+1)) return true;
+		used[w] = false;
+	}
+	return false;
+}
+
+/// Exact comparison. Returns true if the two shapes are isomorphic.
+bool Shape::operator==(const Shape& other) const
+{
+	if (_hash != other._hash) return false;
+	if (_color.size() != other._color.size()) return false;
+	if (_num_edges != other._num_edges) return false;
+
+	// Place the points in the smallest colour classes first; these
+	// have the fewest choices.
+	std::map<size_t, size_t> class_size;
+	for (size_t col : _color) class_size[col]++;
+
+	std::vector<size_t> order(_color.size());
+	for (size_t i = 0; i < order.size(); i++) order[i] = i;
+	std::stable_sort(order.begin(), order.end(),
+		[&](size_t a, size_t b)
+		{ return class_size[_color[a]] < class_size[_color[b]]; });
+
+	std::vector<size_t> perm(_color.size());
+	std::vector<bool> used(_color.size(), false);
+	return match(other, perm, used, order, 0);
+}
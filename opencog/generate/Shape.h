@@ -0,0 +1,89 @@
+/*
+ * opencog/generate/Shape.h
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_SHAPE_H
+#define _OPENCOG_SHAPE_H
+
+#include <map>
+#include <vector>
+
+#include <opencog/atoms/base/Handle.h>
+
+namespace opencog
+{
+/** \addtogroup grp_generate
+ *  @{
+ */
+
+/// The shape of a network: the network with the unique point names
+/// forgotten. Points are labelled by their base name (the part of the
+/// name before the `@` added by `LinkStyle::create_unique_section()`)
+/// and edges by their link type. Two networks have equal shapes if
+/// they are isomorphic, as labelled graphs.
+///
+/// The hash is computed with Weisfeiler-Lehman colour refinement: each
+/// point is repeatedly recoloured by its own colour, and the colours
+/// and edge labels of its neighbours, until the colouring is stable.
+/// Isomorphic networks always have the same hash; networks with the
+/// same hash are compared exactly, by a backtracking search that only
+/// pairs up points of the same colour.
+///
+/// If `with_connectors` is set, then points are labelled by their
+/// entire section: their base name and the sequence of connectors and
+/// link types in it. This is needed to compare partially-assembled
+/// networks, where the unconnected connectors matter.
+///
+/// Points in `pinned` are labelled by their full, unique name, so
+/// that they only match themselves.
+class Shape
+{
+private:
+	/// Final colour of each point.
+	std::vector<size_t> _color;
+
+	/// Sorted edge labels between each pair of points, in both
+	/// directions.
+	std::map<std::pair<size_t, size_t>, std::vector<size_t>> _edges;
+
+	size_t _num_edges;
+	size_t _hash;
+
+	bool match(const Shape&, std::vector<size_t>&,
+	           std::vector<bool>&, const std::vector<size_t>&,
+	           size_t) const;
+
+public:
+	Shape(const HandleSet&, bool with_connectors = false,
+	      const HandleSet& pinned = HandleSet());
+
+	size_t hash(void) const { return _hash; }
+	bool operator==(const Shape&) const;
+
+	static size_t point_key(const Handle&);
+	static size_t section_key(const Handle&);
+	static size_t link_key(const Handle&);
+};
+
+
+/** @}*/
+}  // namespace opencog
+
+#endif // _OPENCOG_SHAPE_H
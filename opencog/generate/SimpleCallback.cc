@@ -37,13 +37,15 @@ void SimpleCallback::clear(AtomSpace* scratch)
 {
 	while (not _lexlit_stack.empty()) _lexlit_stack.pop();
 	while (not _opensel_stack.empty()) _opensel_stack.pop();
-	_lexlit.clear();
-	_opensel._opensect.clear();
-	_opensel._openit.clear();
+	_lexlit_stack.emplace();
+	_opensel_stack.emplace();
 	_root_sections.clear();
 	_root_iters.clear();
 	_steps_taken = 0;
 	CollectStyle::clear();
+	CollectStyle::_isomorphic = dedupe_isomorphic;
+	CollectStyle::_collector = collector;
+	CollectStyle::_stream = stream;
 	LinkStyle::clear();
 	LinkStyle::_point_set = point_set;
 	LinkStyle::_scratch = scratch;
@@ -102,31 +104,32 @@ Handle SimpleCallback::select_from_lexis(const Frame& frame,
                                const Handle& to_con)
 {
 	const HandleSeq& to_sects = _dict.connectables(to_con);
+	HandleUCounter& lexlit = _lexlit_stack.top();
 
 	// Do we have an iterator (a future/promise) for the to-connector?
 	// If not, then set one up. Else use the one we found.  The iterator
 	// that we are setting up here will point into the dictionary, i.e.
 	// into the pool of allowable sections that we can pick from.
-	unsigned curit = _lexlit.get(to_con, 0);
+	unsigned curit = lexlit.get(to_con, 0);
 	if (0 == curit)
 	{
 		// Oh no, dead end!
 		if (0 == to_sects.size()) return Handle::UNDEFINED;
 
 		// Start it up.
-		_lexlit[to_con] = 1;
+		lexlit[to_con] = 1;
 		return create_unique_section(to_sects[0]);
 	}
 
 	if (to_sects.size() <= curit)
 	{
 		// We've iterated to the end; we're done.
-		_lexlit.erase(to_con);
+		lexlit.erase(to_con);
 		return Handle::UNDEFINED;
 	}
 
 	// Increment and save.
-	_lexlit[to_con] ++;
+	lexlit[to_con] ++;
 	return create_unique_section(to_sects[curit]);
 }
 
@@ -135,12 +138,14 @@ Handle SimpleCallback::check_self(const HandleSeq& to_sects,
                                   const Handle& to_con,
                                   size_t fit)
 {
+	OpenSelections& opensel = _opensel_stack.top();
+
 	// We've iterated to the end; we're done.
 	if (to_sects.size() <= fit)
 		return Handle::UNDEFINED;
 
 	// Increment and save.
-	_opensel._openit[to_con] ++;
+	opensel._openit[to_con] ++;
 
 	// If we allow self-connections, then return whatever.
 	if (allow_self_connections) return to_sects[fit];
@@ -151,7 +156,7 @@ Handle SimpleCallback::check_self(const HandleSeq& to_sects,
 		Handle tosect(to_sects[fit]);
 		if (*tosect != *fm_sect) return tosect;
 		fit ++;
-		_opensel._openit[to_con] = fit;
+		opensel._openit[to_con] = fit;
 		if (to_sects.size() <= fit) return Handle::UNDEFINED;
 	}
 }
@@ -162,12 +167,14 @@ Handle SimpleCallback::select_from_open(const Frame& frame,
                                const Handle& fm_sect, size_t offset,
                                const Handle& to_con)
 {
+	OpenSelections& opensel = _opensel_stack.top();
+
 	// Do we have an iterator (a future/promise) for the to-connector
 	// in the current frame? If so, then return that and increment.
-	unsigned fit = _opensel._openit.get(to_con, 0);
+	unsigned fit = opensel._openit.get(to_con, 0);
 	if (0 < fit)
 	{
-		const HandleSeq& to_sects = _opensel._opensect[to_con];
+		const HandleSeq& to_sects = opensel._opensect[to_con];
 		return check_self(to_sects, fm_sect, to_con, fit);
 	}
 
@@ -179,17 +186,22 @@ Handle SimpleCallback::select_from_open(const Frame& frame,
 		const Handle& conseq = open_sect->getOutgoingAtom(1);
 		for (const Handle& con : conseq->getOutgoingSet())
 		{
-			if (*con == *to_con)
-			{
-				// Wait, are these already connected?
-				if (pair_any_links <= num_any_links(fm_sect, open_sect))
-					continue;
-				if (1 < pair_any_links and
-				    pair_typed_links <= num_undirected_links(fm_sect,
-				                                     open_sect, linkty))
-					continue;
-				to_sects.push_back(open_sect);
-			}
+			if (*con != *to_con) continue;
+
+			// Wait, are these already connected?
+			if (pair_any_links <= num_any_links(fm_sect, open_sect))
+				break;
+			if (1 < pair_any_links and
+			    pair_typed_links <= num_undirected_links(fm_sect,
+			                                     open_sect, linkty))
+				break;
+
+			// List each section only once, even if it has several
+			// matching connectors: the aggregator always joins to the
+			// first one, so a second listing would only rediscover
+			// the same linkage.
+			to_sects.push_back(open_sect);
+			break;
 		}
 	}
 
@@ -197,7 +209,7 @@ Handle SimpleCallback::select_from_open(const Frame& frame,
 	if (0 == to_sects.size()) return Handle::UNDEFINED;
 
 	// Start iterating over the sections that contain to_con.
-	_opensel._openit[to_con] = 0;
+	opensel._openit[to_con] = 0;
 	return check_self(to_sects, fm_sect, to_con, 0);
 }
 
@@ -213,7 +225,8 @@ Handle SimpleCallback::select(const Frame& frame,
 	if (open_sect) return open_sect;
 
 	// If this is non-empty, the the odometer rolled over.
-	if (_opensel._opensect.find(to_con) != _opensel._opensect.end())
+	const OpenSelections& opensel = _opensel_stack.top();
+	if (opensel._opensect.find(to_con) != opensel._opensect.end())
 		return Handle::UNDEFINED;
 
 	// Select from the dictionary...
@@ -240,27 +253,27 @@ size_t SimpleCallback::num_links(const Handle& fm_sect,
 	return num_undirected_links(fm_sect, to_sect, link_type);
 }
 
+/// Each frame starts with no open-section iterators. The iterators
+/// of the enclosing frame are untouched, and become current again when
+/// this frame is popped.
 void SimpleCallback::push_frame(const Frame& frm)
 {
-	_opensel_stack.push(_opensel);
-	_opensel._opensect.clear();
-	_opensel._openit.clear();
+	_opensel_stack.emplace();
 }
 
 void SimpleCallback::pop_frame(const Frame& frm)
 {
-	_opensel = _opensel_stack.top(); _opensel_stack.pop();
+	_opensel_stack.pop();
 }
 
 void SimpleCallback::push_odometer(const Odometer& odo)
 {
-	_lexlit_stack.push(_lexlit);
-	_lexlit.clear();
+	_lexlit_stack.emplace();
 }
 
 void SimpleCallback::pop_odometer(const Odometer& odo)
 {
-	_lexlit = _lexlit_stack.top(); _lexlit_stack.pop();
+	_lexlit_stack.pop();
 }
 
 bool SimpleCallback::step(const Frame& frm)
@@ -269,7 +282,7 @@ bool SimpleCallback::step(const Frame& frm)
 	if (max_steps < _steps_taken) return false;
 	if (max_solutions <= num_solutions()) return false;
 	if (max_network_size < frm._linkage.size()) return false;
-	if (max_depth < frm._nodo) return false;
+	if (max_depth < frm._nodo or max_depth < frm._reach) return false;
 	return true;
 }
 
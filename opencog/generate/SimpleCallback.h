@@ -68,9 +68,11 @@ private:
 	// Iterator, pointing from a to-connector, to a list of
 	// all sections in the dictionary that contain this to-connector.
 	// Used by `select()` to return the next attachable section.
-	HandleUCounter _lexlit;
-
-	// Stack of iterators into the lists of sections.
+	//
+	// There is one set of iterators for each odometer level; the top
+	// of the stack is the current level. Each level starts out empty,
+	// so a push just adds an empty entry, and a pop discards only the
+	// iterators created at that level; nothing is ever copied.
 	std::stack<HandleUCounter> _lexlit_stack;
 
 	// -------------------------------------------
@@ -88,7 +90,8 @@ private:
 		HandleUCounter _openit;
 	};
 
-	OpenSelections _opensel;
+	// One for each frame; the top of the stack is the current frame.
+	// As above, pushes and pops do not copy.
 	std::stack<OpenSelections> _opensel_stack;
 	// -------------------------------------------
 
@@ -98,9 +101,12 @@ public:
 
 	virtual void clear(AtomSpace*);
 	virtual bool step(const Frame&);
-	virtual HandleSeq joints(const Handle& con) {
+	virtual const HandleSeq& joints(const Handle& con) {
 		return _dict.joints(con);
 	}
+	virtual size_t min_to_close(const Frame& frm) {
+		return _dict.min_to_close(frm._open_cons);
+	}
 
 	virtual void root_set(const HandleSet&);
 	virtual HandleSet next_root(void);
@@ -119,6 +125,9 @@ public:
 	virtual void pop_odometer(const Odometer&);
 	virtual void solution(const Frame&);
 	virtual Handle get_solutions(void);
+	virtual void visit_solutions(const SolutionVisitor& visit) {
+		CollectStyle::visit_solutions(visit);
+	}
 };
 
 
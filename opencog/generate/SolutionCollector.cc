@@ -0,0 +1,94 @@
+/*
+ * opencog/generate/SolutionCollector.cc
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <opencog/atoms/base/Link.h>
+
+#include "SolutionCollector.h"
+
+using namespace opencog;
+
+SolutionCollector::SolutionCollector(size_t nshards) :
+	_shards(0 < nshards ? nshards : 1), _count(0)
+{
+}
+
+SolutionCollector::~SolutionCollector() {}
+
+/// The hash is a sum, so that it does not depend on the order of the
+/// sections in the set.
+size_t SolutionCollector::hash(const HandleSet& soln)
+{
+	size_t h = 0;
+	for (const Handle& sect : soln)
+		h += std::hash<Handle>()(sect);
+	return h;
+}
+
+SolutionCollector::Shard& SolutionCollector::shard(const HandleSet& soln)
+{
+	return _shards[hash(soln) % _shards.size()];
+}
+
+bool SolutionCollector::insert(const HandleSet& soln)
+{
+	Shard& sh = shard(soln);
+	std::lock_guard<std::mutex> lck(sh.mtx);
+	if (not sh.solutions.insert(soln).second) return false;
+	_count.fetch_add(1, std::memory_order_relaxed);
+	return true;
+}
+
+void SolutionCollector::clear(void)
+{
+	for (Shard& sh : _shards)
+	{
+		std::lock_guard<std::mutex> lck(sh.mtx);
+		sh.solutions.clear();
+	}
+	_count.store(0, std::memory_order_relaxed);
+}
+
+std::set<HandleSet> SolutionCollector::get_solution_set(void)
+{
+	std::set<HandleSet> all;
+	for (Shard& sh : _shards)
+	{
+		std::lock_guard<std::mutex> lck(sh.mtx);
+		all.insert(sh.solutions.begin(), sh.solutions.end());
+	}
+	return all;
+}
+
+/// Return all of the solutions, each as a SetLink of sections, all
+/// wrapped in one big SetLink. The solutions are in the same order as
+/// those returned by `CollectStyle::get_solutions()`.
+Handle SolutionCollector::get_solutions(void)
+{
+	HandleSeq solns;
+	for (const HandleSet& sol : get_solution_set())
+	{
+		HandleSeq sects(sol.begin(), sol.end());
+		solns.push_back(createLink(std::move(sects), SET_LINK));
+	}
+	return createLink(std::move(solns), SET_LINK);
+}
+
+// ========================== END OF FILE ==========================
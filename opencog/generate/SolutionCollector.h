@@ -0,0 +1,84 @@
+/*
+ * opencog/generate/SolutionCollector.h
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_SOLUTION_COLLECTOR_H
+#define _OPENCOG_SOLUTION_COLLECTOR_H
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <vector>
+
+#include <opencog/atoms/base/Handle.h>
+
+namespace opencog
+{
+/** \addtogroup grp_generate
+ *  @{
+ */
+
+/// Set of solutions shared by several aggregations, running on
+/// separate threads.
+///
+/// The solutions are spread over a number of shards, by hash, each
+/// under its own lock, so that threads recording different solutions
+/// rarely wait on one-another. The number of distinct solutions is
+/// kept in an atomic counter, so that `size()` can be checked on every
+/// step without taking any locks; this allows all of the threads to
+/// stop promptly, once enough solutions have been found.
+class SolutionCollector
+{
+private:
+	struct Shard
+	{
+		std::mutex mtx;
+		std::set<HandleSet> solutions;
+	};
+	std::vector<Shard> _shards;
+	std::atomic<size_t> _count;
+
+	Shard& shard(const HandleSet&);
+
+public:
+	SolutionCollector(size_t nshards = 64);
+	~SolutionCollector();
+
+	/// Hash of a solution; independent of the order of the sections.
+	static size_t hash(const HandleSet&);
+
+	/// Add a solution. Returns true if it was not already present.
+	bool insert(const HandleSet&);
+
+	/// Number of distinct solutions recorded, by all threads.
+	size_t size(void) const {
+		return _count.load(std::memory_order_relaxed);
+	}
+
+	void clear(void);
+	std::set<HandleSet> get_solution_set(void);
+	Handle get_solutions(void);
+};
+
+
+/** @}*/
+}  // namespace opencog
+
+#endif // _OPENCOG_SOLUTION_COLLECTOR_H
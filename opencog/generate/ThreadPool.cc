@@ -0,0 +1,78 @@
+/*
+ * opencog/generate/ThreadPool.cc
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "ThreadPool.h"
+
+using namespace opencog;
+
+ThreadPool::ThreadPool(size_t nthreads) : _stop(false)
+{
+	if (0 == nthreads) nthreads = std::thread::hardware_concurrency();
+	if (0 == nthreads) nthreads = 1;
+
+	for (size_t i = 0; i < nthreads; i++)
+		_workers.emplace_back(&ThreadPool::work, this);
+}
+
+/// Jobs that have not yet started are dropped.
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lck(_mtx);
+		_stop = true;
+		_jobs.clear();
+	}
+	_cv.notify_all();
+	for (std::thread& thr : _workers) thr.join();
+}
+
+void ThreadPool::submit(std::function<void()> job)
+{
+	{
+		std::lock_guard<std::mutex> lck(_mtx);
+		_jobs.emplace_back(std::move(job));
+	}
+	_cv.notify_one();
+}
+
+void ThreadPool::work(void)
+{
+	while (true)
+	{
+		std::function<void()> job;
+		{
+			std::unique_lock<std::mutex> lck(_mtx);
+			_cv.wait(lck, [this] { return _stop or not _jobs.empty(); });
+			if (_stop) return;
+			job = std::move(_jobs.front());
+			_jobs.pop_front();
+		}
+		job();
+	}
+}
+
+ThreadPool& ThreadPool::shared(void)
+{
+	static ThreadPool pool;
+	return pool;
+}
+
+// ========================== END OF FILE ==========================
@@ -0,0 +1,67 @@
+/*
+ * opencog/generate/ThreadPool.h
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_THREAD_POOL_H
+#define _OPENCOG_THREAD_POOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace opencog
+{
+/** \addtogroup grp_generate
+ *  @{
+ */
+
+/// A fixed set of worker threads, running jobs in the order that they
+/// were submitted. Used to run aggregations in the background; see
+/// `Aggregate::aggregate_async()`.
+class ThreadPool
+{
+private:
+	std::vector<std::thread> _workers;
+	std::deque<std::function<void()>> _jobs;
+	std::mutex _mtx;
+	std::condition_variable _cv;
+	bool _stop;
+
+	void work(void);
+
+public:
+	/// Zero threads means one per core.
+	ThreadPool(size_t nthreads = 0);
+	~ThreadPool();
+
+	void submit(std::function<void()>);
+
+	/// The pool shared by all aggregators.
+	static ThreadPool& shared(void);
+};
+
+
+/** @}*/
+}  // namespace opencog
+
+#endif // _OPENCOG_THREAD_POOL_H
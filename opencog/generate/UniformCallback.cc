@@ -0,0 +1,464 @@
+/*
+ * opencog/generate/UniformCallback.cc
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <deque>
+
+#include <opencog/atoms/base/Link.h>
+#include <opencog/atoms/value/FloatValue.h>
+
+#include "UniformCallback.h"
+
+using namespace opencog;
+
+UniformCallback::UniformCallback(AtomSpace* as, const Dictionary& dict) :
+	GenerateCallback(as), _dict(dict)
+{
+	_steps_taken = 0;
+	_table_size = 0;
+
+	std::random_device seed;
+	_rangen.seed(seed());
+
+	max_solutions = 100;
+
+	// The counting tables are sized by this; it must be finite.
+	max_network_size = 20;
+}
+
+UniformCallback::~UniformCallback() {}
+
+void UniformCallback::clear(AtomSpace* scratch)
+{
+	_pieces.clear();
+	_attachables.clear();
+	_con_count.clear();
+	_fm_count.clear();
+	_roots.clear();
+	_root_cdf.clear();
+	_plans.clear();
+	_table_size = 0;
+
+	_steps_taken = 0;
+	CollectStyle::clear();
+	CollectStyle::_isomorphic = dedupe_isomorphic;
+	CollectStyle::_collector = collector;
+	CollectStyle::_stream = stream;
+	LinkStyle::clear();
+	LinkStyle::_point_set = point_set;
+	LinkStyle::_scratch = scratch;
+}
+
+/// Return the weight of a lexis section. Weights are multiplied
+/// together, and so sections without a weight get a weight of one.
+/// If none of the sections have weights, the draw is uniform.
+double UniformCallback::weight(const Handle& sect)
+{
+	if (nullptr == _weight_key) return 1.0;
+
+	FloatValuePtr fvp(FloatValueCast(sect->getValue(_weight_key)));
+	if (fvp) return fvp->value()[0];
+	return 1.0;
+}
+
+// ===============================================================
+// Counting tables.
+
+/// Create a piece for the lexis section `sect`, attached by the
+/// connector at offset `attach`. Pass `SIZE_MAX` for root pieces,
+/// which are not attached to anything. Returns the index of the piece.
+size_t UniformCallback::make_piece(const Handle& sect, size_t attach)
+{
+	Piece pc;
+	pc.section = sect;
+	pc.attach = attach;
+	pc.weight = weight(sect);
+
+	const HandleSeq& conseq = sect->getOutgoingAtom(1)->getOutgoingSet();
+	for (size_t idx = 0; idx < conseq.size(); idx++)
+	{
+		if (idx == attach) continue;
+
+		// A connector that cannot be joined has no joints; such pieces
+		// will always have a count of zero.
+		pc.kids.push_back(idx);
+		pc.cons.push_back(conseq[idx]);
+	}
+
+	_pieces.emplace_back(std::move(pc));
+	return _pieces.size() - 1;
+}
+
+/// Build the counting tables, for all pieces reachable from the
+/// sections rooted at the `roots` points.
+///
+/// The count of sub-trees of size `n` hanging off of a to-connector
+/// is the sum over all pieces attachable to it; the count for a
+/// from-connector is the sum over all of it's joints. The count for a piece
+/// is it's weight, times the number of ways of distributing `n-1`
+/// sections among the sub-trees hanging off of it's kids. The latter
+/// is a convolution of the counts of it's kids, built up one kid at
+/// a time, in the `prefix` table. Since every kid carries at least one
+/// section, the tables for size `n` depend only on those for smaller
+/// sizes, and so can be filled in order of increasing size.
+void UniformCallback::build_tables(const HandleSet& roots)
+{
+	if (SIZE_MAX == max_network_size)
+		throw RuntimeException(TRACE_INFO,
+			"UniformCallback requires a finite max_network_size");
+
+	_table_size = max_network_size;
+
+	// Discover all of the pieces, working outwards from the roots.
+	std::deque<Handle> work;
+	auto enqueue = [&](size_t ip)
+	{
+		for (const Handle& fm_con : _pieces[ip].cons)
+		{
+			if (_fm_count.end() != _fm_count.find(fm_con)) continue;
+			_fm_count[fm_con] = std::vector<double>(_table_size+1, 0.0);
+
+			const HandleSeq& to_cons = _dict.joints(fm_con);
+
+			// The odometer only ever connects with the first joint of
+			// a connector; the other joints are tried only depth-first.
+			if (1 < to_cons.size() and BREADTH_FIRST == strategy)
+				throw RuntimeException(TRACE_INFO,
+					"UniformCallback: connector %s has %lu joints; "
+					"use a depth-first strategy",
+					fm_con->to_short_string().c_str(), to_cons.size());
+
+			for (const Handle& mate : to_cons)
+			{
+				if (_con_count.end() != _con_count.find(mate)) continue;
+				_con_count[mate] = std::vector<double>(_table_size+1, 0.0);
+				work.push_back(mate);
+			}
+		}
+	};
+
+	for (const Handle& point: roots)
+	{
+		const HandleSeq& sects = _dict.entries(point);
+		if (0 == sects.size())
+			throw RuntimeException(TRACE_INFO,
+				"No dictionary entry for root=%s", point->to_string().c_str());
+
+		for (const Handle& sect: sects)
+		{
+			size_t ip = make_piece(sect, SIZE_MAX);
+			_roots.push_back(ip);
+			enqueue(ip);
+		}
+	}
+
+	while (not work.empty())
+	{
+		Handle to_con = work.front(); work.pop_front();
+		std::vector<size_t>& attachable = _attachables[to_con];
+		for (const Handle& sect : _dict.connectables(to_con))
+		{
+			// The aggregator attaches at the first matching connector.
+			const HandleSeq& conseq = sect->getOutgoingAtom(1)->getOutgoingSet();
+			size_t attach = 0;
+			while (*conseq[attach] != *to_con) attach++;
+
+			size_t ip = make_piece(sect, attach);
+			attachable.push_back(ip);
+			enqueue(ip);
+		}
+	}
+
+	// Allocate the tables.
+	for (Piece& pc : _pieces)
+	{
+		pc.prefix.assign(pc.kids.size() + 1,
+			std::vector<double>(_table_size, 0.0));
+		pc.prefix[0][0] = 1.0;
+		pc.count.assign(_table_size + 1, 0.0);
+	}
+
+	// Fill them in, in order of increasing size.
+	for (size_t n = 1; n <= _table_size; n++)
+	{
+		size_t m = n - 1;
+		for (Piece& pc : _pieces)
+		{
+			for (size_t j = 1; j <= pc.kids.size(); j++)
+			{
+				const std::vector<double>& kid = _fm_count[pc.cons[j-1]];
+				const std::vector<double>& prev = pc.prefix[j-1];
+				double sum = 0.0;
+				for (size_t i = 1; i <= m; i++)
+					sum += prev[m-i] * kid[i];
+				pc.prefix[j][m] = sum;
+			}
+			pc.count[n] = pc.weight * pc.prefix[pc.kids.size()][m];
+		}
+
+		for (auto& att : _attachables)
+		{
+			double sum = 0.0;
+			for (size_t ip : att.second)
+				sum += _pieces[ip].count[n];
+			_con_count[att.first][n] = sum;
+		}
+
+		for (auto& fm : _fm_count)
+		{
+			double sum = 0.0;
+			for (const Handle& mate : _dict.joints(fm.first))
+				sum += _con_count[mate][n];
+			fm.second[n] = sum;
+		}
+	}
+
+	// The cumulative counts of the roots, for every size, so that
+	// each root can be drawn with a binary search.
+	_root_cdf.clear();
+	double sum = 0.0;
+	for (size_t ip : _roots)
+		for (size_t n = 1; n <= _table_size; n++)
+		{
+			sum += _pieces[ip].count[n];
+			_root_cdf.push_back(sum);
+		}
+
+	logger().fine("Built counting tables for %lu pieces, %lu connectors, size %lu",
+		_pieces.size(), _con_count.size(), _table_size);
+}
+
+void UniformCallback::root_set(const HandleSet& roots)
+{
+	build_tables(roots);
+}
+
+// ===============================================================
+// Drawing.
+
+/// Return a number drawn uniformly from `[0, total)`.
+double UniformCallback::draw(double total)
+{
+	std::uniform_real_distribution<double> dist(0.0, total);
+	return dist(_rangen);
+}
+
+/// Split a budget of `m` sections between the first `j` kids of the
+/// piece and kid `j`: return the size `i` of the sub-tree hung off of
+/// kid `j`, drawn in proportion to `prefix[j-1][m-i] * kid[i]`.
+///
+/// The cumulative sum is searched from both ends at once, stopping as
+/// soon as the draw is found, so that the cost is the smaller of `i`
+/// and `m-i`, and not `m`. Summed over all of the pieces in a network
+/// of size `n`, this is at most O(n log n); the plain search from one
+/// end would be O(n^2) for long, thin trees. This is the "boustrophedon"
+/// search of Flajolet, Zimmermann and Van Cutsem.
+size_t UniformCallback::split(const Piece& pc, size_t j, size_t m)
+{
+	const std::vector<double>& kid = _fm_count.at(pc.cons[j-1]);
+	const std::vector<double>& prev = pc.prefix[j-1];
+	double total = pc.prefix[j][m];
+
+	double lo_target = draw(total);
+	double hi_target = total - lo_target;
+	double lo_sum = 0.0;
+	double hi_sum = 0.0;
+	size_t lo = 1;
+	size_t hi = m;
+	size_t last = 0;
+	while (lo <= hi)
+	{
+		double term = prev[m-lo] * kid[lo];
+		if (0.0 < term) last = lo;
+		lo_sum += term;
+		if (lo_target < lo_sum) return lo;
+		lo++;
+		if (hi < lo) break;
+
+		term = prev[m-hi] * kid[hi];
+		if (0.0 < term) last = hi;
+		hi_sum += term;
+		if (0.0 < term and hi_target <= hi_sum) return hi;
+		hi--;
+	}
+
+	// Only reached if rounding left the target just out of reach.
+	return last;
+}
+
+/// Draw the joint of `fm_con` that a sub-tree of size `n` will hang
+/// off of, in proportion to the counts for each joint.
+Handle UniformCallback::draw_joint(const Handle& fm_con, size_t n)
+{
+	const HandleSeq& to_cons = _dict.joints(fm_con);
+	double target = draw(_fm_count.at(fm_con)[n]);
+	double sum = 0.0;
+	Handle pick;
+	for (const Handle& mate : to_cons)
+	{
+		double cnt = _con_count[mate][n];
+		if (cnt <= 0.0) continue;
+		pick = mate;
+		sum += cnt;
+		if (target < sum) break;
+	}
+	return pick;
+}
+
+/// Create a unique instance of the piece, to be the top of a sub-tree
+/// of size `n`, and split the remaining `n-1` sections among it's kids.
+/// The split is drawn one kid at a time, starting with the last, in
+/// proportion to the number of ways of filling in the remaining kids.
+/// Then, for each kid, the joint is drawn.
+Handle UniformCallback::draw_piece(const Piece& pc, size_t n)
+{
+	Handle usect = create_unique_section(pc.section);
+	const Handle& upoint = usect->getOutgoingAtom(0);
+
+	size_t arity = usect->getOutgoingAtom(1)->get_arity();
+	Plan plan;
+	plan.size.assign(arity, 0);
+	plan.joint.assign(arity, Handle::UNDEFINED);
+	size_t m = n - 1;
+	for (size_t j = pc.kids.size(); 0 < j; j--)
+	{
+		size_t i = split(pc, j, m);
+		plan.size[pc.kids[j-1]] = i;
+		plan.joint[pc.kids[j-1]] = draw_joint(pc.cons[j-1], i);
+		m -= i;
+	}
+
+	_plans.emplace(std::make_pair(upoint, std::move(plan)));
+	return usect;
+}
+
+/// Draw a root piece, and the size of the network, jointly, in
+/// proportion to the number of networks of that size, having that
+/// root. Each call results in exactly one network.
+HandleSet UniformCallback::next_root(void)
+{
+	static HandleSet empty_set;
+	if (0 == _roots.size()) return empty_set;
+
+	// Stop iterating if limits have been reached.
+	if (max_steps < _steps_taken) return empty_set;
+	if (max_solutions <= num_solutions()) return empty_set;
+
+	// The previous network is done; its plan is no longer needed.
+	_plans.clear();
+
+	if (_root_cdf.empty() or _root_cdf.back() <= 0.0)
+	{
+		logger().fine("There are no networks of size %lu or less",
+			_table_size);
+		return empty_set;
+	}
+
+	double target = draw(_root_cdf.back());
+	size_t idx = std::upper_bound(_root_cdf.begin(), _root_cdf.end(), target)
+		- _root_cdf.begin();
+	if (_root_cdf.size() <= idx) idx = _root_cdf.size() - 1;
+
+	const Piece& root = _pieces[_roots[idx / _table_size]];
+	size_t n = idx % _table_size + 1;
+
+	logger().fine("Drawing network of size %lu", n);
+	return HandleSet({draw_piece(root, n)});
+}
+
+/// Return the section planned for the connector at `offset` on the
+/// point of `fm_sect`. The plan is handed out only once, and only for
+/// the planned joint; otherwise, the undefined handle is returned, so
+/// that the odometer rolls over, or the next joint is tried.
+Handle UniformCallback::select(const Frame& frame,
+                               const Handle& fm_sect, size_t offset,
+                               const Handle& to_con)
+{
+	auto pit = _plans.find(fm_sect->getOutgoingAtom(0));
+	if (_plans.end() == pit) return Handle::UNDEFINED;
+
+	Plan& plan = pit->second;
+	size_t n = plan.size[offset];
+	if (0 == n) return Handle::UNDEFINED;
+	if (*plan.joint[offset] != *to_con) return Handle::UNDEFINED;
+	plan.size[offset] = 0;
+
+	auto ait = _attachables.find(to_con);
+	if (_attachables.end() == ait) return Handle::UNDEFINED;
+
+	// The counts for the connector are the sums of those for the
+	// pieces, so there is no need to total them up again.
+	double total = _con_count[to_con][n];
+	if (total <= 0.0) return Handle::UNDEFINED;
+
+	double target = draw(total);
+	double sum = 0.0;
+	size_t pick = SIZE_MAX;
+	for (size_t ip : ait->second)
+	{
+		double cnt = _pieces[ip].count[n];
+		if (cnt <= 0.0) continue;
+		pick = ip;
+		sum += cnt;
+		if (target < sum) break;
+	}
+
+	return draw_piece(_pieces[pick], n);
+}
+
+/// Create an undirected edge connecting the two points `fm_pnt` and
+/// `to_pnt`, using the connectors `fm_con` and `to_con`.
+Handle UniformCallback::make_link(const Handle& fm_con,
+                                  const Handle& to_con,
+                                  const Handle& fm_pnt,
+                                  const Handle& to_pnt)
+{
+	return create_undirected_link(fm_con, to_con, fm_pnt, to_pnt);
+}
+
+size_t UniformCallback::num_links(const Handle& fm_sect,
+                                  const Handle& to_sect,
+                                  const Handle& link_type)
+{
+	return num_undirected_links(fm_sect, to_sect, link_type);
+}
+
+bool UniformCallback::step(const Frame& frm)
+{
+	_steps_taken ++;
+	if (max_steps < _steps_taken) return false;
+	if (max_solutions <= num_solutions()) return false;
+	return true;
+}
+
+void UniformCallback::solution(const Frame& frm)
+{
+	record_solution(frm);
+}
+
+Handle UniformCallback::get_solutions(void)
+{
+	Handle results = CollectStyle::get_solutions();
+
+	// Populate the atomspace, only if there are results to report.
+	if (0 < results->get_arity()) LinkStyle::save_work(_as);
+	return results;
+}
@@ -0,0 +1,183 @@
+/*
+ * opencog/generate/UniformCallback.h
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_UNIFORM_CALLBACK_H
+#define _OPENCOG_UNIFORM_CALLBACK_H
+
+#include <random>
+
+#include <opencog/generate/CollectStyle.h>
+#include <opencog/generate/Dictionary.h>
+#include <opencog/generate/GenerateCallback.h>
+#include <opencog/generate/LinkStyle.h>
+
+namespace opencog
+{
+/** \addtogroup grp_generate
+ *  @{
+ */
+
+/// Callback that draws tree-shaped networks exactly uniformly (or,
+/// if a weight key is given, exactly in proportion to the product of
+/// the weights of the pieces), with no rejection.
+///
+/// Before any drawing is done, counting tables are built: for each
+/// to-connector, and for each size budget `n` up to the maximum
+/// network size, the (weighted) number of distinct sub-trees of size
+/// `n` that can be hung off of that connector. A network is then drawn
+/// top-down: first the root piece and the total size, then, for each
+/// piece, a split of the remaining size budget among its connectors,
+/// and then the pieces attached to those connectors, each in proportion
+/// to the counts.  The drawn network is then handed to the aggregator,
+/// one piece per `select()` call. Every draw results in a complete
+/// network; `select()` never offers an alternative, and so the
+/// odometer simply rolls over once the network is complete.
+///
+/// Once the tables are built, drawing a network of size `n` costs
+/// O(n log n) in the worst case, which is reached for long, thin trees;
+/// bushy trees cost close to O(n).
+///
+/// Only trees are drawn: open connectors are never joined to one
+/// another, as cycles cannot be counted with this method.
+///
+/// A connector with several joints has its sub-trees counted over
+/// all of them, and the joint is drawn along with the size. The
+/// odometer only ever tries the first joint, and so such dictionaries
+/// must be used with a depth-first strategy; `root_set()` throws if
+/// the strategy is `BREADTH_FIRST`.
+///
+class UniformCallback :
+	public GenerateCallback,
+	private LinkStyle,
+	private CollectStyle
+{
+private:
+	Dictionary _dict;
+	Handle _weight_key;
+	size_t _steps_taken;
+	std::mt19937 _rangen;
+
+	double weight(const Handle&);
+
+	// -------------------------------------------
+	// Counting tables.
+
+	/// A lexis section, attached to the network by the connector at
+	/// `attach`. The remaining connectors are the `kids`; `cons` holds
+	/// the connector at each kid.
+	struct Piece
+	{
+		Handle section;
+		size_t attach;
+		double weight;
+		std::vector<size_t> kids;
+		HandleSeq cons;
+
+		/// `prefix[j][m]` is the weighted number of ways of hanging
+		/// sub-trees, totalling `m` sections, off of the first `j` kids.
+		std::vector<std::vector<double>> prefix;
+
+		/// `count[n]` is the weighted number of sub-trees of size `n`
+		/// having this piece at the top.
+		std::vector<double> count;
+	};
+	std::vector<Piece> _pieces;
+
+	/// Map from a to-connector, to the pieces that can attach to it.
+	std::map<Handle, std::vector<size_t>> _attachables;
+
+	/// Map from a to-connector, to the weighted number of sub-trees
+	/// of size `n` that can attach to it.
+	std::map<Handle, std::vector<double>> _con_count;
+
+	/// Map from a from-connector, to the weighted number of sub-trees
+	/// of size `n` that can hang off of it, summed over it's joints.
+	std::map<Handle, std::vector<double>> _fm_count;
+
+	/// Pieces that can serve as the root.
+	std::vector<size_t> _roots;
+
+	/// Cumulative counts of the roots: entry `r * _table_size + n - 1`
+	/// is the weighted number of networks having one of the first `r`
+	/// roots, or root `r` and a size of `n` or less.
+	std::vector<double> _root_cdf;
+
+	size_t _table_size;
+	size_t make_piece(const Handle&, size_t);
+	void build_tables(const HandleSet&);
+
+	// -------------------------------------------
+	// Drawing.
+
+	/// Size budget, and the joint to use, for each connector on a
+	/// drawn (unique) point. Sizes are zeroed once the connector has
+	/// been handed out.
+	struct Plan
+	{
+		std::vector<size_t> size;
+		HandleSeq joint;
+	};
+	std::map<Handle, Plan> _plans;
+
+	double draw(double);
+	size_t split(const Piece&, size_t, size_t);
+	Handle draw_joint(const Handle&, size_t);
+	Handle draw_piece(const Piece&, size_t);
+
+public:
+	UniformCallback(AtomSpace*, const Dictionary&);
+	virtual ~UniformCallback();
+
+	virtual void clear(AtomSpace*);
+	void set_weight_key(const Handle& pred) { _weight_key = pred; }
+	void seed(unsigned long s) { _rangen.seed(s); }
+
+	virtual void root_set(const HandleSet&);
+	virtual HandleSet next_root(void);
+
+	virtual const HandleSeq& joints(const Handle& con) {
+		return _dict.joints(con);
+	}
+	virtual size_t min_to_close(const Frame& frm) {
+		return _dict.min_to_close(frm._open_cons);
+	}
+	virtual Handle select(const Frame&,
+	                      const Handle&, size_t,
+	                      const Handle&);
+
+	virtual Handle make_link(const Handle&, const Handle&,
+	                         const Handle&, const Handle&);
+	virtual size_t num_links(const Handle&, const Handle&,
+	                         const Handle&);
+
+	virtual bool step(const Frame&);
+	virtual void solution(const Frame&);
+	virtual Handle get_solutions(void);
+	virtual void visit_solutions(const SolutionVisitor& visit) {
+		CollectStyle::visit_solutions(visit);
+	}
+};
+
+
+/** @}*/
+}  // namespace opencog
+
+#endif // _OPENCOG_UNIFORM_CALLBACK_H
@@ -19,6 +19,11 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+
 #include <opencog/atoms/core/NumberNode.h>
 #include <opencog/atoms/core/StateLink.h>
 #include <opencog/guile/SchemeModule.h>
@@ -26,9 +31,12 @@
 
 #include <opencog/generate/Aggregate.h>
 #include <opencog/generate/Dictionary.h>
+#include <opencog/generate/Growth.h>
+#include <opencog/generate/AdaptiveParameters.h>
 #include <opencog/generate/BasicParameters.h>
 #include <opencog/generate/RandomCallback.h>
 #include <opencog/generate/SimpleCallback.h>
+#include <opencog/generate/UniformCallback.h>
 
 using namespace opencog;
 namespace opencog {
@@ -36,6 +44,12 @@ namespace opencog {
 /**
  * Scheme wrapper for the generation code. Quick Hack.
  * Mediocre, ugly-ish API.  XXX FIXME.
+ *
+ * Each call decodes its own dictionary and parameters, and builds its
+ * own callback (with its own random number generator) and aggregator
+ * (with its own scratch AtomSpace). Nothing is shared between calls,
+ * other than the AtomSpace itself, which is thread-safe. Thus, these
+ * may be called from several guile threads at once.
  */
 
 class GenerateSCM : public ModuleWrap
@@ -45,6 +59,33 @@ protected:
 
 	Handle do_random_aggregate(Handle, Handle, Handle, Handle, Handle);
 	Handle do_simple_aggregate(Handle, Handle, Handle, Handle);
+	Handle do_uniform_aggregate(Handle, Handle, Handle, Handle, Handle);
+	Handle do_grow(Handle, Handle, Handle, Handle);
+	Handle do_random_extend(Handle, Handle, Handle, Handle, Handle);
+	Handle do_simple_extend(Handle, Handle, Handle, Handle);
+
+	Handle do_aggregate_async(Handle, Handle, Handle, Handle, Handle);
+	Handle do_aggregate_poll(Handle);
+	Handle do_aggregate_wait(Handle);
+	Handle do_aggregate_cancel(Handle);
+
+	/// A random aggregation running in the background. Everything it
+	/// uses is kept here, until the results are collected.
+	struct AsyncJob
+	{
+		AtomSpace* as;
+		BasicParameters basic;
+		AdaptiveParameters adaptive;
+		std::unique_ptr<RandomCallback> cb;
+		std::unique_ptr<Aggregate> ag;
+		std::shared_future<Handle> result;
+	};
+	std::map<size_t, std::shared_ptr<AsyncJob>> _jobs;
+	std::mutex _jobs_mtx;
+	size_t _next_job = 0;
+
+	std::shared_ptr<AsyncJob> get_job(const Handle&);
+	Handle finish_job(const Handle&, const std::shared_ptr<AsyncJob>&);
 
 public:
 	GenerateSCM();
@@ -63,7 +104,8 @@ public:
 ///
 void decode_param(const Handle& membli,
                   GenerateCallback& cb,
-                  BasicParameters& basic)
+                  BasicParameters& basic,
+                  bool& adaptive)
 {
 	Handle statli = StateLink::get_link(membli);
 	if (nullptr == statli) return;
@@ -86,6 +128,82 @@ void decode_param(const Handle& membli,
 		return;
 	}
 
+	// We expect the name of the policy.
+	if (0 == sname.compare("*-restart-policy-*"))
+	{
+		const std::string& policy = pval->get_name();
+		if (0 == policy.compare("none"))
+			basic.restart_policy = BasicParameters::NO_RESTART;
+		else if (0 == policy.compare("fixed"))
+			basic.restart_policy = BasicParameters::FIXED_RESTART;
+		else if (0 == policy.compare("luby"))
+			basic.restart_policy = BasicParameters::LUBY_RESTART;
+		else if (0 == policy.compare("geometric"))
+			basic.restart_policy = BasicParameters::GEOMETRIC_RESTART;
+		else
+			throw InvalidParamException(TRACE_INFO,
+				"Unknown restart policy, got %s",
+				pval->to_short_string().c_str());
+		return;
+	}
+
+	// We expect the name of the search strategy.
+	if (0 == sname.compare("*-strategy-*"))
+	{
+		const std::string& strat = pval->get_name();
+		if (0 == strat.compare("breadth-first"))
+			cb.strategy = GenerateCallback::BREADTH_FIRST;
+		else if (0 == strat.compare("depth-first"))
+			cb.strategy = GenerateCallback::DEPTH_FIRST;
+		else if (0 == strat.compare("iterative-deepening"))
+			cb.strategy = GenerateCallback::ITERATIVE_DEEPENING;
+		else if (0 == strat.compare("meet-in-the-middle"))
+			cb.strategy = GenerateCallback::MEET_IN_THE_MIDDLE;
+		else
+			throw InvalidParamException(TRACE_INFO,
+				"Unknown search strategy, got %s",
+				pval->to_short_string().c_str());
+		return;
+	}
+
+	// We expect a list of (link-type, number) pairs, e.g.
+	//    (List (List (Concept "S") (Number 1)) (List (Concept "O") (Number 1)))
+	if (0 == sname.compare("*-link-limits-*"))
+	{
+		cb.link_limits.clear();
+		for (const Handle& pr : pval->getOutgoingSet())
+		{
+			if (2 != pr->get_arity() or not nameserver().isA(
+			      pr->getOutgoingAtom(1)->get_type(), NUMBER_NODE))
+				throw InvalidParamException(TRACE_INFO,
+					"Expecting a link type and a limit, got %s",
+					pr->to_short_string().c_str());
+			cb.link_limits[pr->getOutgoingAtom(0)] =
+				NumberNodeCast(pr->getOutgoingAtom(1))->get_value();
+		}
+		return;
+	}
+
+	// We expect a list of connector pairs, e.g.
+	//    (List (List (Connector (Concept "WV") (ConnectorDir "+"))
+	//                (Connector (Concept "WV") (ConnectorDir "-"))))
+	if (0 == sname.compare("*-must-close-*"))
+	{
+		cb.must_close.clear();
+		for (const Handle& pr : pval->getOutgoingSet())
+		{
+			if (2 != pr->get_arity() or
+			    CONNECTOR != pr->getOutgoingAtom(0)->get_type() or
+			    CONNECTOR != pr->getOutgoingAtom(1)->get_type())
+				throw InvalidParamException(TRACE_INFO,
+					"Expecting a pair of connectors, got %s",
+					pr->to_short_string().c_str());
+			cb.must_close.insert({pr->getOutgoingAtom(0),
+			                      pr->getOutgoingAtom(1)});
+		}
+		return;
+	}
+
 	// All parameters below here expect a NumberNode
 	if (not nameserver().isA(pval->get_type(), NUMBER_NODE))
 		throw InvalidParamException(TRACE_INFO,
@@ -105,25 +223,86 @@ void decode_param(const Handle& membli,
 	else if(0 == sname.compare("*-max-network-size-*"))
 		cb.max_network_size = dval;
 
+	else if (0 == sname.compare("*-dedupe-isomorphic-*"))
+		cb.dedupe_isomorphic = (0.0 != dval);
+
+	else if (0 == sname.compare("*-max-transpositions-*"))
+		cb.max_transpositions = dval;
+
+	else if (0 == sname.compare("*-meet-radius-*"))
+		cb.meet_radius = dval;
+
+	else if (0 == sname.compare("*-planar-*"))
+		cb.planar = (0.0 != dval);
+
+	else if (0 == sname.compare("*-projective-*"))
+		cb.projective = (0.0 != dval);
+
 	else if (0 == sname.compare("*-close-fraction-*"))
 		basic.close_fraction = dval;
+
+	else if (0 == sname.compare("*-adaptive-*"))
+		adaptive = (0.0 != dval);
+
+	else if (0 == sname.compare("*-restart-steps-*"))
+		basic.restart_steps = dval;
+
+	else if (0 == sname.compare("*-restart-growth-*"))
+		basic.restart_growth = dval;
 }
 
 /// Decode all parameters attached to an anchor point.
 /// See `decode_param()` above. This is just a loop.
 void decode_params(const Handle& param_anchor,
                    GenerateCallback& cb,
-                   BasicParameters& basic)
+                   BasicParameters& basic,
+                   bool& adaptive)
 {
 	// Decode the parameters. One at a time.
 	HandleSeq memps = param_anchor->getIncomingSetByType(MEMBER_LINK);
 	for (const Handle& membli : memps)
 	{
 		if (*membli->getOutgoingAtom(1) != *param_anchor) continue;
-		decode_param(membli, cb, basic);
+		decode_param(membli, cb, basic, adaptive);
 	}
 }
 
+/// Same as above, for callbacks that make no random draws.
+void decode_params(const Handle& param_anchor,
+                   GenerateCallback& cb,
+                   BasicParameters& basic)
+{
+	bool adaptive = false;
+	decode_params(param_anchor, cb, basic, adaptive);
+}
+
+/// Same as above, for the RandomCallback. The draws are made according
+/// to the BasicParameters, unless the `*-adaptive-*` parameter is set;
+/// then `adaptive` is copied from `basic`, and used instead.
+void decode_params(const Handle& param_anchor,
+                   RandomCallback& cb,
+                   BasicParameters& basic,
+                   AdaptiveParameters& adaptive)
+{
+	bool use_adaptive = false;
+	decode_params(param_anchor, cb, basic, use_adaptive);
+	if (not use_adaptive) return;
+
+	adaptive = AdaptiveParameters(basic);
+	cb.set_parameters(adaptive);
+}
+
+// ----------------------------------------------------------------
+/// The nucleation points. This is either a single point, or a SetLink
+/// of several points, all of which will appear in every network.
+HandleSet decode_nuclei(const Handle& root)
+{
+	if (SET_LINK == root->get_type())
+		return HandleSet(root->getOutgoingSet().begin(),
+		                 root->getOutgoingSet().end());
+	return {root};
+}
+
 // ----------------------------------------------------------------
 /// Pull the lexis out of the atomspace.
 Dictionary decode_lexis(AtomSpace* as, Handle poles, Handle lexis)
@@ -171,14 +350,15 @@ Handle GenerateSCM::do_random_aggregate(Handle poles,
 	Dictionary dict(decode_lexis(as, poles, lexis));
 
 	BasicParameters basic;
+	AdaptiveParameters adaptive;
 	RandomCallback cb(as, dict, basic);
 	cb.set_weight_key(weight);
 
 	// Decode the parameters.
-	decode_params(params, cb, basic);
+	decode_params(params, cb, basic, adaptive);
 
 	Aggregate ag(as);
-	ag.aggregate({root}, cb);
+	ag.aggregate(decode_nuclei(root), cb);
 
 	Handle result = cb.get_solutions();
 	result = as->add_atom(result);
@@ -201,13 +381,198 @@ Handle GenerateSCM::do_simple_aggregate(Handle poles,
 	decode_params(params, cb, basic);
 
 	Aggregate ag(as);
-	ag.aggregate({root}, cb);
+	ag.aggregate(decode_nuclei(root), cb);
+
+	Handle result = cb.get_solutions();
+	result = as->add_atom(result);
+	return result;
+}
+
+// ----------------------------------------------------------------
+/// C++ implementation of the scheme function.
+Handle GenerateSCM::do_uniform_aggregate(Handle poles,
+                                         Handle lexis,
+                                         Handle weight,
+                                         Handle params,
+                                         Handle root)
+{
+	AtomSpace* as = SchemeSmob::ss_get_env_as("cog-uniform-aggregate");
+
+	Dictionary dict(decode_lexis(as, poles, lexis));
+
+	BasicParameters basic;
+	UniformCallback cb(as, dict);
+	cb.set_weight_key(weight);
+	decode_params(params, cb, basic);
+
+	Aggregate ag(as);
+	ag.aggregate(decode_nuclei(root), cb);
 
 	Handle result = cb.get_solutions();
 	result = as->add_atom(result);
 	return result;
 }
 
+// ----------------------------------------------------------------
+/// C++ implementation of the scheme function.
+Handle GenerateSCM::do_random_extend(Handle poles,
+                                     Handle lexis,
+                                     Handle weight,
+                                     Handle params,
+                                     Handle network)
+{
+	AtomSpace* as = SchemeSmob::ss_get_env_as("cog-random-extend");
+
+	Dictionary dict(decode_lexis(as, poles, lexis));
+
+	BasicParameters basic;
+	AdaptiveParameters adaptive;
+	RandomCallback cb(as, dict, basic);
+	cb.set_weight_key(weight);
+
+	decode_params(params, cb, basic, adaptive);
+
+	Aggregate ag(as);
+	ag.extend(HandleSet(network->getOutgoingSet().begin(),
+	                    network->getOutgoingSet().end()), cb);
+
+	Handle result = cb.get_solutions();
+	result = as->add_atom(result);
+	return result;
+}
+
+// ----------------------------------------------------------------
+/// C++ implementation of the scheme function.
+Handle GenerateSCM::do_simple_extend(Handle poles,
+                                     Handle lexis,
+                                     Handle params,
+                                     Handle network)
+{
+	AtomSpace* as = SchemeSmob::ss_get_env_as("cog-simple-extend");
+
+	Dictionary dict(decode_lexis(as, poles, lexis));
+
+	BasicParameters basic;
+	SimpleCallback cb(as, dict);
+	decode_params(params, cb, basic);
+
+	Aggregate ag(as);
+	ag.extend(HandleSet(network->getOutgoingSet().begin(),
+	                    network->getOutgoingSet().end()), cb);
+
+	Handle result = cb.get_solutions();
+	result = as->add_atom(result);
+	return result;
+}
+
+// ----------------------------------------------------------------
+/// C++ implementation of the scheme function.
+/// Only the network size and step limits apply to growth; these are
+/// decoded like all the others, and then handed over.
+Handle GenerateSCM::do_grow(Handle poles,
+                            Handle lexis,
+                            Handle params,
+                            Handle seed)
+{
+	AtomSpace* as = SchemeSmob::ss_get_env_as("cog-grow");
+
+	Dictionary dict(decode_lexis(as, poles, lexis));
+
+	BasicParameters basic;
+	SimpleCallback cb(as, dict);
+	decode_params(params, cb, basic);
+
+	Growth gr(as, dict);
+	gr.max_network_size = cb.max_network_size;
+	gr.max_steps = cb.max_steps;
+
+	Handle result = gr.grow(seed);
+	result = as->add_atom(result);
+	return result;
+}
+
+// ----------------------------------------------------------------
+/// Start a random aggregation on the thread pool, and return at once.
+/// The job is identified by the NumberNode that is returned.
+Handle GenerateSCM::do_aggregate_async(Handle poles,
+                                       Handle lexis,
+                                       Handle weight,
+                                       Handle params,
+                                       Handle root)
+{
+	AtomSpace* as = SchemeSmob::ss_get_env_as("cog-aggregate-async");
+
+	std::shared_ptr<AsyncJob> job(std::make_shared<AsyncJob>());
+	job->as = as;
+	job->cb.reset(new RandomCallback(as,
+		decode_lexis(as, poles, lexis), job->basic));
+	job->cb->set_weight_key(weight);
+
+	decode_params(params, *job->cb, job->basic, job->adaptive);
+
+	job->ag.reset(new Aggregate(as));
+	job->result = job->ag->aggregate_async(decode_nuclei(root), *job->cb).share();
+
+	std::lock_guard<std::mutex> lck(_jobs_mtx);
+	size_t id = _next_job++;
+	_jobs[id] = job;
+	return as->add_node(NUMBER_NODE, std::to_string(id));
+}
+
+std::shared_ptr<GenerateSCM::AsyncJob>
+GenerateSCM::get_job(const Handle& jobid)
+{
+	if (not nameserver().isA(jobid->get_type(), NUMBER_NODE))
+		throw InvalidParamException(TRACE_INFO,
+			"Expecting an aggregation job, got %s",
+			jobid->to_short_string().c_str());
+
+	size_t id = NumberNodeCast(jobid)->get_value();
+	std::lock_guard<std::mutex> lck(_jobs_mtx);
+	auto jit = _jobs.find(id);
+	if (_jobs.end() == jit)
+		throw InvalidParamException(TRACE_INFO,
+			"No such aggregation job: %s",
+			jobid->to_short_string().c_str());
+	return jit->second;
+}
+
+/// Wait for the job to finish, forget about it, and return its
+/// results.
+Handle GenerateSCM::finish_job(const Handle& jobid,
+                               const std::shared_ptr<AsyncJob>& job)
+{
+	Handle result = job->result.get();
+	{
+		std::lock_guard<std::mutex> lck(_jobs_mtx);
+		_jobs.erase((size_t) NumberNodeCast(jobid)->get_value());
+	}
+	return job->as->add_atom(result);
+}
+
+/// Return the results, if the job is done, else the undefined handle.
+Handle GenerateSCM::do_aggregate_poll(Handle jobid)
+{
+	std::shared_ptr<AsyncJob> job(get_job(jobid));
+	if (std::future_status::ready !=
+	    job->result.wait_for(std::chrono::seconds(0)))
+		return Handle::UNDEFINED;
+	return finish_job(jobid, job);
+}
+
+Handle GenerateSCM::do_aggregate_wait(Handle jobid)
+{
+	return finish_job(jobid, get_job(jobid));
+}
+
+/// Stop the job, and return whatever it found so far.
+Handle GenerateSCM::do_aggregate_cancel(Handle jobid)
+{
+	std::shared_ptr<AsyncJob> job(get_job(jobid));
+	job->ag->cancel();
+	return finish_job(jobid, job);
+}
+
 // ----------------------------------------------------------------
 } /*end of namespace opencog*/
 
@@ -221,6 +586,22 @@ void GenerateSCM::init(void)
 		&GenerateSCM::do_random_aggregate, this, "generate");
 	define_scheme_primitive("cog-simple-aggregate",
 		&GenerateSCM::do_simple_aggregate, this, "generate");
+	define_scheme_primitive("cog-uniform-aggregate",
+		&GenerateSCM::do_uniform_aggregate, this, "generate");
+	define_scheme_primitive("cog-random-extend",
+		&GenerateSCM::do_random_extend, this, "generate");
+	define_scheme_primitive("cog-simple-extend",
+		&GenerateSCM::do_simple_extend, this, "generate");
+	define_scheme_primitive("cog-grow",
+		&GenerateSCM::do_grow, this, "generate");
+	define_scheme_primitive("cog-aggregate-async",
+		&GenerateSCM::do_aggregate_async, this, "generate");
+	define_scheme_primitive("cog-aggregate-poll",
+		&GenerateSCM::do_aggregate_poll, this, "generate");
+	define_scheme_primitive("cog-aggregate-wait",
+		&GenerateSCM::do_aggregate_wait, this, "generate");
+	define_scheme_primitive("cog-aggregate-cancel",
+		&GenerateSCM::do_aggregate_cancel, this, "generate");
 }
 
 extern "C" {
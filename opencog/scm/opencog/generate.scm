@@ -13,6 +13,14 @@
 (export
 	cog-random-aggregate
 	cog-simple-aggregate
+	cog-uniform-aggregate
+	cog-random-extend
+	cog-simple-extend
+	cog-grow
+	cog-aggregate-async
+	cog-aggregate-poll
+	cog-aggregate-wait
+	cog-aggregate-cancel
 )
 
 (include-from-path "opencog/generate/gml-export.scm")
@@ -28,6 +36,9 @@
     connectable enpoints are given by POLES. Some parameters
     controlling the search are in PARAMS.
 
+    ROOT may also be a SetLink of several points; each network will
+    then contain all of them.
+
     See the example `basic-network.scm` for more details.
 ")
 
@@ -39,5 +50,114 @@
     in the LEXIS, and the connectable enpoints given by POLES. Some
     parameters controlling the search are in PARAMS.
 
+    ROOT may also be a SetLink of several points; each network will
+    then contain all of them.
+
     See the examples `dict-tree.scm` and `dict-loop.scm` for more details.
 ")
+
+(set-procedure-property! cog-uniform-aggregate 'documentation
+"
+  cog-uniform-aggregate POLES LEXIS WEIGHT PARAMS ROOT
+
+    Draw random tree-shaped networks around ROOT, using the sections
+    defined in the LEXIS, and the connectable enpoints given by POLES.
+    Unlike `cog-random-aggregate`, each network is drawn exactly in
+    proportion to the product of the WEIGHTs of the sections in it,
+    out of all networks no larger than the maximum network size given
+    in PARAMS. Sections without a WEIGHT count as having a weight of
+    one; if none of them have one, then all networks are drawn with
+    equal probability. Cycles are never formed.
+
+    See the example `basic-network.scm` for more details.
+")
+
+(set-procedure-property! cog-random-extend 'documentation
+"
+  cog-random-extend POLES LEXIS WEIGHT PARAMS NETWORK
+
+    Extend the NETWORK, a SetLink of sections, some of which have
+    unconnected connectors, just as `cog-random-aggregate` would have,
+    had it drawn those sections itself. The complete sections of the
+    NETWORK are not looked at, and are added back in to each of the
+    networks returned. The maximum network size in PARAMS limits only
+    the unconnected sections, and what is added to them; it does not
+    count the rest of the NETWORK.
+
+    Example:
+       ; Connect up the newcomers.
+       (define nets (cog-random-extend poles lexis weights params
+          (Set (Section ...) (Section ...) ...)))
+")
+
+(set-procedure-property! cog-simple-extend 'documentation
+"
+  cog-simple-extend POLES LEXIS PARAMS NETWORK
+
+    As `cog-random-extend`, but extending the NETWORK in all of the
+    ways that `cog-simple-aggregate` would.
+")
+
+(set-procedure-property! cog-grow 'documentation
+"
+  cog-grow POLES LEXIS PARAMS SEED
+
+    Grow the network SEED, by repeatedly breaking a randomly chosen
+    link, and inserting a section from the LEXIS in its place. Any
+    other connectors on the inserted section are closed with sections
+    from the LEXIS that have just one connector. The connectable
+    endpoints are given by POLES. SEED must be a complete network, such
+    as one of the networks returned by `cog-simple-aggregate`. The
+    network stops growing when it reaches the maximum network size
+    given in PARAMS, or after the maximum number of steps.
+
+    Returns the grown network, in the same form as SEED.
+
+    Example:
+       (define nets (cog-simple-aggregate poles lexis params root))
+       (define big (cog-grow poles lexis params (gar nets)))
+")
+
+(set-procedure-property! cog-aggregate-async 'documentation
+"
+  cog-aggregate-async POLES LEXIS WEIGHT PARAMS ROOT
+
+    Start a `cog-random-aggregate` running in the background, and
+    return at once. A NumberNode identifying the job is returned; pass
+    it to `cog-aggregate-poll`, `cog-aggregate-wait` or
+    `cog-aggregate-cancel` to get the results. The arguments are the
+    same as for `cog-random-aggregate`.
+
+    Example:
+       (define job (cog-aggregate-async poles lexis weights params root))
+       ... do other things ...
+       (define nets (cog-aggregate-wait job))
+")
+
+(set-procedure-property! cog-aggregate-poll 'documentation
+"
+  cog-aggregate-poll JOB
+
+    If the JOB started with `cog-aggregate-async` is done, return the
+    results, exactly as `cog-random-aggregate` would have. Otherwise,
+    return the empty list. Once the results have been returned, the
+    JOB is forgotten.
+")
+
+(set-procedure-property! cog-aggregate-wait 'documentation
+"
+  cog-aggregate-wait JOB
+
+    Wait for the JOB started with `cog-aggregate-async` to finish, and
+    return the results. Once the results have been returned, the JOB
+    is forgotten.
+")
+
+(set-procedure-property! cog-aggregate-cancel 'documentation
+"
+  cog-aggregate-cancel JOB
+
+    Stop the JOB started with `cog-aggregate-async`, and return the
+    networks that it found before it was stopped. Once the results have
+    been returned, the JOB is forgotten.
+")
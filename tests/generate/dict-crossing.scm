@@ -0,0 +1,46 @@
+;
+; dict-crossing.scm
+;
+; Crossing test: dictionary that allows just one network, and that
+; network cannot be drawn without the links crossing, when the
+; connectors of each word are taken in the order given:
+;
+;                +-------BD--------+
+;         +------|-AC----+         |
+;         +--AB--+--BC---+---CD----+
+;         |      |       |         |
+;       alpha   beta   gamma     delta
+;
+; The AC and BD links cross. With the `planar` or `projective`
+; parameters set, there are no solutions at all.
+;
+(use-modules (srfi srfi-1))
+(use-modules (opencog) (opencog exec))
+
+(define alpha (Concept "alpha"))
+
+(Section
+	(Concept "alpha")
+	(ConnectorSeq
+		(Connector (Concept "AC") (ConnectorDir "+"))
+		(Connector (Concept "AB") (ConnectorDir "+"))))
+
+(Section
+	(Concept "beta")
+	(ConnectorSeq
+		(Connector (Concept "AB") (ConnectorDir "-"))
+		(Connector (Concept "BD") (ConnectorDir "+"))
+		(Connector (Concept "BC") (ConnectorDir "+"))))
+
+(Section
+	(Concept "gamma")
+	(ConnectorSeq
+		(Connector (Concept "BC") (ConnectorDir "-"))
+		(Connector (Concept "AC") (ConnectorDir "-"))
+		(Connector (Concept "CD") (ConnectorDir "+"))))
+
+(Section
+	(Concept "delta")
+	(ConnectorSeq
+		(Connector (Concept "CD") (ConnectorDir "-"))
+		(Connector (Concept "BD") (ConnectorDir "-"))))
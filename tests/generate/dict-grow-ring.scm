@@ -0,0 +1,45 @@
+;
+; dict-grow-ring.scm
+;
+; Growth test: dictionary whose smallest network has a pair of parallel
+; links, that is, a cycle of length two:
+;
+;        +---B---+
+;        |       |
+;      north   south
+;        |       |
+;        +---B---+
+;
+; Inserting "link" into either B link gives ever-larger rings. The
+; "north" piece also comes with the connector directions reversed;
+; only one of its two forms fits into the network.
+;
+(use-modules (srfi srfi-1))
+(use-modules (opencog) (opencog exec))
+
+(define south (Concept "south"))
+
+; A test dictionary of basic data.
+(Section
+	(Concept "north")
+	(ConnectorSeq
+		(Connector (Concept "B") (ConnectorDir "-"))
+		(Connector (Concept "B") (ConnectorDir "-"))))
+
+(Section
+	(Concept "north")
+	(ConnectorSeq
+		(Connector (Concept "B") (ConnectorDir "+"))
+		(Connector (Concept "B") (ConnectorDir "+"))))
+
+(Section
+	(Concept "south")
+	(ConnectorSeq
+		(Connector (Concept "B") (ConnectorDir "-"))
+		(Connector (Concept "B") (ConnectorDir "-"))))
+
+(Section
+	(Concept "link")
+	(ConnectorSeq
+		(Connector (Concept "B") (ConnectorDir "-"))
+		(Connector (Concept "B") (ConnectorDir "+"))))
@@ -0,0 +1,59 @@
+;
+; dict-grow.scm
+;
+; Growth test: dictionary in which pieces can be inserted into every
+; W link, forever. The smallest network is
+;
+;        +----W---+
+;        |        |
+;     LEFT-WALL  cats
+;
+; and inserting "big", "fat" and "and" into its links gives networks
+; such as
+;
+;                           +--------W-------+
+;        +----W---+----W----+---A---+        |
+;        |        |         |       |        |
+;     LEFT-WALL  big       and     very     cats
+;
+; where "and" always brings a "very" leaf along with it.
+;
+(use-modules (srfi srfi-1))
+(use-modules (opencog) (opencog exec))
+
+(define left-wall (Concept "LEFT-WALL"))
+
+; A test dictionary of basic data.
+(Section
+	(Concept "LEFT-WALL")
+	(ConnectorSeq
+		(Connector (Concept "W") (ConnectorDir "+"))))
+
+(Section
+	(Concept "cats")
+	(ConnectorSeq
+		(Connector (Concept "W") (ConnectorDir "-"))))
+
+(Section
+	(Concept "big")
+	(ConnectorSeq
+		(Connector (Concept "W") (ConnectorDir "-"))
+		(Connector (Concept "W") (ConnectorDir "+"))))
+
+(Section
+	(Concept "fat")
+	(ConnectorSeq
+		(Connector (Concept "W") (ConnectorDir "-"))
+		(Connector (Concept "W") (ConnectorDir "+"))))
+
+(Section
+	(Concept "and")
+	(ConnectorSeq
+		(Connector (Concept "W") (ConnectorDir "-"))
+		(Connector (Concept "A") (ConnectorDir "+"))
+		(Connector (Concept "W") (ConnectorDir "+"))))
+
+(Section
+	(Concept "very")
+	(ConnectorSeq
+		(Connector (Concept "A") (ConnectorDir "-"))))
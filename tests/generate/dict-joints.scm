@@ -0,0 +1,32 @@
+;
+; dict-joints.scm
+;
+; Joints test: the wall connector can mate with either of two others,
+; so that there are two networks, each of size two:
+;
+;        +----W---+          +----W---+
+;        |        |          |        |
+;     LEFT-WALL  John     LEFT-WALL  Mary
+;
+; "John" mates with "-" and "Mary" with "*"; the wall "+" mates with
+; both. The "*" direction is the second joint of the wall connector.
+;
+(use-modules (srfi srfi-1))
+(use-modules (opencog) (opencog exec))
+
+(define left-wall (Concept "LEFT-WALL"))
+
+(Section
+	(Concept "LEFT-WALL")
+	(ConnectorSeq
+		(Connector (Concept "W") (ConnectorDir "+"))))
+
+(Section
+	(Concept "John")
+	(ConnectorSeq
+		(Connector (Concept "W") (ConnectorDir "-"))))
+
+(Section
+	(Concept "Mary")
+	(ConnectorSeq
+		(Connector (Concept "W") (ConnectorDir "*"))))